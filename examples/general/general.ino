@@ -8,6 +8,11 @@
  *      - TCA95XX_16BIT
  *      - HT8574
  *      - CH422G
+ *      - PCAL95XX_8BIT
+ *      - PCAL95XX_16BIT
+ *      - TCA6424
+ *      - MCP23017
+ *      - AW9523B
  */
 #define EXAMPLE_CHIP_NAME       TCA95XX_8BIT
 #define EXAMPLE_I2C_SDA_PIN     (47)
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "inttypes.h"
+#include "esp_expander_utils.h"
+#include "port/esp_io_expander_aw9523b.h"
+#include "esp_expander_aw9523b.hpp"
+
+namespace esp_expander {
+
+AW9523B::~AW9523B()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool AW9523B::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::BEGIN), false, "Already begun");
+
+    // Initialize the bus if not initialized
+    if (!isOverState(State::INIT)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(init(), false, "Init failed");
+    }
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_new_i2c_aw9523b(
+            static_cast<i2c_port_t>(getConfig().host_id), getConfig().device.address, &device_handle
+        ), false, "Create AW9523B failed"
+    );
+    ESP_UTILS_LOGD("Create AW9523B @%p", device_handle);
+
+    setState(State::BEGIN);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool AW9523B::setLedMode(uint32_t pin_mask, bool enable)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), enable(%d)", pin_mask, enable);
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_aw9523b_set_led_mode(device_handle, pin_mask, enable), false, "Set LED mode failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool AW9523B::setLedCurrent(uint8_t pin, uint8_t level)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(pin < 16, false, "Invalid pin");
+    ESP_UTILS_CHECK_FALSE_RETURN(multiSetLedCurrent(BIT(pin), level), false, "Set LED current failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool AW9523B::multiSetLedCurrent(uint32_t pin_mask, uint8_t level)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), level(%d)", pin_mask, level);
+
+    // Only written if any pin isn't in LED mode yet
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_aw9523b_set_led_mode(device_handle, pin_mask, true), false, "Set LED mode failed"
+    );
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_aw9523b_set_led_current(device_handle, pin_mask, level), false, "Set LED current failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool AW9523B::writeLedCurrents(uint8_t start_pin, const uint8_t *levels, size_t num)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: start_pin(%d), levels(@%p), num(%d)", start_pin, levels, static_cast<int>(num));
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_aw9523b_write_led_currents(device_handle, start_pin, levels, num), false,
+        "Write LED currents failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+} // namespace esp_expander
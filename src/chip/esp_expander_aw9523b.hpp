@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The AW9523B IO expander device class
+ *
+ * @note  This class is a derived class of `esp_expander::Base`, user can use it directly
+ * @note  Each pin can be switched to the constant-current LED mode with 256 dimming levels, which are kept by the chip
+ *        without any bus traffic
+ */
+class AW9523B: public Base {
+public:
+    /**
+     * @brief Construct a AW9523B device. With this function, call `init()` will initialize I2C by using the host
+     *        configuration.
+     *
+     * @param[in] scl_io  I2C SCL pin number
+     * @param[in] sda_io  I2C SDA pin number
+     * @param[in] address I2C device 7-bit address. Should be like `ESP_IO_EXPANDER_I2C_<chip name>_ADDRESS`.
+     */
+    AW9523B(int scl_io, int sda_io, uint8_t address): Base(scl_io, sda_io, address) {}
+
+    /**
+     * @brief Construct a AW9523B device. With this function, call `init()` will not initialize I2C, and users
+     *        should initialize it manually.
+     *
+     * @param[in] host_id I2C host ID.
+     * @param[in] address I2C device 7-bit address. Should be like `ESP_IO_EXPANDER_I2C_<chip name>_ADDRESS`.
+     */
+    AW9523B(int host_id, uint8_t address): Base(host_id, address) {}
+
+    /**
+     * @brief Construct a AW9523B device.
+     *
+     * @param[in] config Configuration for the object
+     */
+    AW9523B(const Config &config): Base(config) {}
+
+    /**
+     * @brief Desutruct object. This function will call `del()` to delete the object.
+     */
+    ~AW9523B() override;
+
+    /**
+     * @brief Begin object
+     *
+     * @note  This function typically calls `esp_io_expander_new_i2c_*()` to create the IO expander handle.
+     * @note  This function sets all pins to inpurt mode by default.
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void) override;
+
+    /**
+     * @brief Switch multiple pins between the constant-current LED mode and the GPIO mode
+     *
+     * @param[in] pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] enable   true for LED mode, false for GPIO mode
+     *
+     * @return true if success, otherwise false
+     */
+    bool setLedMode(uint32_t pin_mask, bool enable);
+
+    /**
+     * @brief Set the LED current level of a pin
+     *
+     * @note  The pin is switched to LED mode if it isn't
+     *
+     * @param[in] pin   Pin number (0-15)
+     * @param[in] level Current level, 0 (off) to 255 (maximum)
+     *
+     * @return true if success, otherwise false
+     */
+    bool setLedCurrent(uint8_t pin, uint8_t level);
+
+    /**
+     * @brief Set the same LED current level of multiple pins in a single I2C burst
+     *
+     * @note  The pins are switched to LED mode if they aren't
+     *
+     * @param[in] pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] level    Current level, 0 (off) to 255 (maximum)
+     *
+     * @return true if success, otherwise false
+     */
+    bool multiSetLedCurrent(uint32_t pin_mask, uint8_t level);
+
+    /**
+     * @brief Set the LED current levels of consecutive pins in a single I2C burst
+     *
+     * @note  The pins should be switched to LED mode by `setLedMode()` first
+     *
+     * @param[in] start_pin First pin (0-15)
+     * @param[in] levels    Current levels of the pins from `start_pin`, 0 (off) to 255 (maximum)
+     * @param[in] num       Number of the levels
+     *
+     * @return true if success, otherwise false
+     */
+    bool writeLedCurrents(uint8_t start_pin, const uint8_t *levels, size_t num);
+};
+
+} // namespace esp_expander
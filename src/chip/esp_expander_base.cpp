@@ -196,10 +196,31 @@ bool Base::pinMode(uint8_t pin, uint8_t mode)
 
     ESP_UTILS_LOGD("Param: pin(%d), mode(%d)", pin, mode);
     ESP_UTILS_CHECK_FALSE_RETURN(IS_VALID_PIN(pin), false, "Invalid pin");
-    ESP_UTILS_CHECK_FALSE_RETURN((mode == INPUT) || (mode == OUTPUT), false, "Invalid mode");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (mode == INPUT) || (mode == INPUT_PULLUP) || (mode == INPUT_PULLDOWN) || (mode == OUTPUT) ||
+        (mode == OUTPUT_OPEN_DRAIN), false, "Invalid mode"
+    );
 
-    esp_io_expander_dir_t dir = (mode == INPUT) ? IO_EXPANDER_INPUT : IO_EXPANDER_OUTPUT;
-    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_set_dir(device_handle, BIT64(pin), dir), false, "Set dir failed");
+    // Set the pull resistor before the direction, so an unsupported pull leaves the mode unchanged
+    bool pull_supported = (device_handle->set_pull != nullptr);
+    if ((mode == INPUT_PULLUP) || (mode == INPUT_PULLDOWN)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(pull_supported, false, "Pull resistor not supported");
+        esp_io_expander_pull_t pull = (mode == INPUT_PULLUP) ? IO_EXPANDER_PULL_UP : IO_EXPANDER_PULL_DOWN;
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_set_pull(device_handle, BIT64(pin), pull), false, "Set pull failed");
+    } else if (((mode == INPUT) || (mode == OUTPUT)) && pull_supported) {
+        // Like Arduino, `INPUT` and `OUTPUT` clear the pull resistor set before
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_io_expander_set_pull(device_handle, BIT64(pin), IO_EXPANDER_PULL_NONE), false, "Clear pull failed"
+        );
+    }
+    if (mode == OUTPUT_OPEN_DRAIN) {
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_io_expander_set_open_drain(device_handle, BIT64(pin)), false, "Set open-drain failed"
+        );
+    } else {
+        esp_io_expander_dir_t dir = (mode == OUTPUT) ? IO_EXPANDER_OUTPUT : IO_EXPANDER_INPUT;
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_set_dir(device_handle, BIT64(pin), dir), false, "Set dir failed");
+    }
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
@@ -250,10 +271,31 @@ bool Base::multiPinMode(uint32_t pin_mask, uint8_t mode)
     ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
 
     ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), mode(%d)", pin_mask, mode);
-    ESP_UTILS_CHECK_FALSE_RETURN((mode == INPUT) || (mode == OUTPUT), false, "Invalid mode");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (mode == INPUT) || (mode == INPUT_PULLUP) || (mode == INPUT_PULLDOWN) || (mode == OUTPUT) ||
+        (mode == OUTPUT_OPEN_DRAIN), false, "Invalid mode"
+    );
 
-    esp_io_expander_dir_t dir = (mode == INPUT) ? IO_EXPANDER_INPUT : IO_EXPANDER_OUTPUT;
-    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_set_dir(device_handle, pin_mask, dir), false, "Set dir failed");
+    // Set the pull resistor before the direction, so an unsupported pull leaves the mode unchanged
+    bool pull_supported = (device_handle->set_pull != nullptr);
+    if ((mode == INPUT_PULLUP) || (mode == INPUT_PULLDOWN)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(pull_supported, false, "Pull resistor not supported");
+        esp_io_expander_pull_t pull = (mode == INPUT_PULLUP) ? IO_EXPANDER_PULL_UP : IO_EXPANDER_PULL_DOWN;
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_set_pull(device_handle, pin_mask, pull), false, "Set pull failed");
+    } else if (((mode == INPUT) || (mode == OUTPUT)) && pull_supported) {
+        // Like Arduino, `INPUT` and `OUTPUT` clear the pull resistor set before
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_io_expander_set_pull(device_handle, pin_mask, IO_EXPANDER_PULL_NONE), false, "Clear pull failed"
+        );
+    }
+    if (mode == OUTPUT_OPEN_DRAIN) {
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_io_expander_set_open_drain(device_handle, pin_mask), false, "Set open-drain failed"
+        );
+    } else {
+        esp_io_expander_dir_t dir = (mode == OUTPUT) ? IO_EXPANDER_OUTPUT : IO_EXPANDER_INPUT;
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_set_dir(device_handle, pin_mask, dir), false, "Set dir failed");
+    }
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
@@ -275,6 +317,119 @@ bool Base::multiDigitalWrite(uint32_t pin_mask, uint8_t value)
     return true;
 }
 
+bool Base::multiPinModeOutput(uint32_t pin_mask, uint32_t values)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), values(0x%" PRIx32 ")", pin_mask, values);
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_set_output(device_handle, pin_mask, values), false, "Set output failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::multiDigitalWriteStream(uint32_t pin_mask, const uint32_t *values, size_t count)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), values(@%p), count(%d)", pin_mask, values, static_cast<int>(count));
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_write_output_stream(device_handle, pin_mask, values, count), false, "Write stream failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::multiSetPull(uint32_t pin_mask, esp_io_expander_pull_t pull)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), pull(%d)", pin_mask, pull);
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_set_pull(device_handle, pin_mask, pull), false, "Set pull failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::multiSetDriveStrength(uint32_t pin_mask, esp_io_expander_drive_t drive)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), drive(%d)", pin_mask, drive);
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_set_drive(device_handle, pin_mask, drive), false, "Set drive failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::multiSetInputLatch(uint32_t pin_mask, bool enable)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), enable(%d)", pin_mask, enable);
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_set_input_latch(device_handle, pin_mask, enable), false, "Set input latch failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::multiSetInterruptEnable(uint32_t pin_mask, bool enable)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), enable(%d)", pin_mask, enable);
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_set_int_enable(device_handle, pin_mask, enable), false, "Set interrupt enable failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::getInterruptStatus(uint32_t &status_mask)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_get_int_status(device_handle, &status_mask), false, "Get interrupt status failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 int64_t Base::multiDigitalRead(uint32_t pin_mask)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -291,6 +446,208 @@ int64_t Base::multiDigitalRead(uint32_t pin_mask)
     return level;
 }
 
+bool Base::enableInterrupt(int int_io)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: int_io(%d)", int_io);
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_enable_int(device_handle, int_io), false, "Enable INT failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::disableInterrupt(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_disable_int(device_handle), false, "Disable INT failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::setPollInterval(uint32_t interval_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: interval_ms(%d)", static_cast<int>(interval_ms));
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_set_poll_interval(device_handle, interval_ms), false, "Set poll interval failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::waitFor(uint8_t pin, uint8_t value, uint32_t timeout_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(IS_VALID_PIN(pin), false, "Invalid pin");
+
+    bool ret = multiWaitFor(BIT64(pin), value, timeout_ms);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return ret;
+}
+
+bool Base::multiWaitFor(uint32_t pin_mask, uint8_t value, uint32_t timeout_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD(
+        "Param: pin_mask(0x%" PRIx32 "), value(%d), timeout_ms(%d)", pin_mask, value, static_cast<int>(timeout_ms)
+    );
+
+    esp_err_t ret = esp_io_expander_wait_level(device_handle, pin_mask, value, timeout_ms);
+    if (ret == ESP_ERR_TIMEOUT) {
+        ESP_UTILS_LOGD("Wait timeout");
+        return false;
+    }
+    ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Wait level failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::subscribe(const esp_io_expander_subscribe_config_t &config, int &subscriber_id)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pin_mask(0x%" PRIx32 "), edge(%d)", config.pin_num_mask, static_cast<int>(config.edge));
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_subscribe(device_handle, &config, &subscriber_id), false, "Subscribe failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::unsubscribe(int subscriber_id)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_unsubscribe(device_handle, subscriber_id), false, "Unsubscribe failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::checkChanges(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_check_changes(device_handle), false, "Check changes failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::startMonitor(const esp_io_expander_monitor_config_t &config)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_start_monitor(device_handle, &config), false, "Start monitor failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::startMonitor(void)
+{
+    const esp_io_expander_monitor_config_t config = ESP_IO_EXPANDER_MONITOR_CONFIG_DEFAULT();
+
+    return startMonitor(config);
+}
+
+bool Base::stopMonitor(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_stop_monitor(device_handle), false, "Stop monitor failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::addRule(const esp_io_expander_rule_t &rule, int &rule_id)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD(
+        "Param: input(0x%" PRIx32 "/0x%" PRIx32 "), output(0x%" PRIx32 "/0x%" PRIx32 ")", rule.input_pin_num_mask,
+        rule.input_level_mask, rule.output_pin_num_mask, rule.output_level_mask
+    );
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_add_rule(device_handle, &rule, &rule_id), false, "Add rule failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::removeRule(int rule_id)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_remove_rule(device_handle, rule_id), false, "Remove rule failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Base::getRuleStats(esp_io_expander_rule_stats_t &stats, bool reset)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_get_rule_stats(device_handle, &stats, reset), false, "Get rule stats failed"
+    );
+
+    return true;
+}
+
 bool Base::printStatus(void) const
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -18,6 +18,15 @@
 #ifndef OUTPUT
 #define OUTPUT            0x03
 #endif
+#ifndef OUTPUT_OPEN_DRAIN
+#define OUTPUT_OPEN_DRAIN 0x13
+#endif
+#ifndef INPUT_PULLUP
+#define INPUT_PULLUP      0x05
+#endif
+#ifndef INPUT_PULLDOWN
+#define INPUT_PULLDOWN    0x09
+#endif
 #ifndef LOW
 #define LOW               0x0
 #endif
@@ -183,8 +192,13 @@ public:
      *
      * @note  This function is same as Arduino's `pinMode()`.
      *
+     * @note  In `OUTPUT_OPEN_DRAIN` mode, LOW drives the pin low and HIGH releases it, each by a single register write.
+     *        Not supported by the chips without per-pin direction (e.g. CH422G).
+     * @note  `INPUT_PULLUP` and `INPUT_PULLDOWN` are only supported by the chips with pull resistors (e.g. PCAL95xx).
+     *        On these chips, `INPUT` and `OUTPUT` turn the pull resistor off.
+     *
      * @param[in] pin  Pin number (0-31)
-     * @param[in] mode Pin mode (INPUT / OUTPUT)
+     * @param[in] mode Pin mode (INPUT / INPUT_PULLUP / INPUT_PULLDOWN / OUTPUT / OUTPUT_OPEN_DRAIN)
      *
      * @return true if success, otherwise false
      */
@@ -217,7 +231,7 @@ public:
      * @brief Set multiple pin modes
      *
      * @param pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
-     * @param mode     Mode to set (INPUT / OUTPUT)
+     * @param mode     Mode to set (INPUT / INPUT_PULLUP / INPUT_PULLDOWN / OUTPUT / OUTPUT_OPEN_DRAIN)
      *
      * @return true if success, otherwise false
      */
@@ -233,6 +247,19 @@ public:
      */
     bool multiDigitalWrite(uint32_t pin_mask, uint8_t value);
 
+    /**
+     * @brief Set multiple pins to output mode, starting at the given levels
+     *
+     * @note  The levels are latched before the pins start driving, so there is no glitch on them. Unlike
+     *        `multiDigitalWrite()`, the pins don't need to be in output mode first.
+     *
+     * @param[in] pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] values   Levels to start at, every bit represents a pin (HIGH / LOW)
+     *
+     * @return true if success, otherwise false
+     */
+    bool multiPinModeOutput(uint32_t pin_mask, uint32_t values);
+
     /**
      * @brief Read multiple pin levels
      *
@@ -242,6 +269,213 @@ public:
      */
     int64_t multiDigitalRead(uint32_t pin_mask);
 
+    /**
+     * @brief Write a sequence of levels to multiple pins, one after another
+     *
+     * @note  If the chip supports it (e.g. HT8574), the whole sequence is written in a single transaction, so the
+     *        waveform runs at the bus byte rate instead of the transaction rate.
+     *
+     * @param[in] pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] values   Sequence of levels, every bit represents a pin (HIGH / LOW)
+     * @param[in] count    Number of levels in the sequence
+     *
+     * @return true if success, otherwise false
+     */
+    bool multiDigitalWriteStream(uint32_t pin_mask, const uint32_t *values, size_t count);
+
+    /**
+     * @brief Set the pull resistor of multiple pins
+     *
+     * @note  Only supported by the chips with pull resistors (e.g. PCAL95xx)
+     *
+     * @param[in] pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] pull     Pull resistor
+     *
+     * @return true if success, otherwise false
+     */
+    bool multiSetPull(uint32_t pin_mask, esp_io_expander_pull_t pull);
+
+    /**
+     * @brief Set the output drive strength of multiple pins
+     *
+     * @note  Only supported by the chips with configurable drive strength (e.g. PCAL95xx)
+     *
+     * @param[in] pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] drive    Drive strength
+     *
+     * @return true if success, otherwise false
+     */
+    bool multiSetDriveStrength(uint32_t pin_mask, esp_io_expander_drive_t drive);
+
+    /**
+     * @brief Enable or disable the input latch of multiple pins
+     *
+     * @note  Only supported by the chips with input latches (e.g. PCAL95xx). A latched input keeps its changed level
+     *        until it is read, so a pulse shorter than the interval between two reads isn't lost.
+     *
+     * @param[in] pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] enable   Enable or disable
+     *
+     * @return true if success, otherwise false
+     */
+    bool multiSetInputLatch(uint32_t pin_mask, bool enable);
+
+    /**
+     * @brief Enable or disable the interrupt of multiple pins
+     *
+     * @note  Only supported by the chips with interrupt mask (e.g. PCAL95xx), the others interrupt on all inputs
+     *
+     * @param[in] pin_mask Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] enable   Enable or disable
+     *
+     * @return true if success, otherwise false
+     */
+    bool multiSetInterruptEnable(uint32_t pin_mask, bool enable);
+
+    /**
+     * @brief Get the pins whose input changed since they were read last time
+     *
+     * @note  Only supported by the chips with interrupt status (e.g. PCAL95xx)
+     *
+     * @param[out] status_mask Changed pins, every bit represents a pin
+     *
+     * @return true if success, otherwise false
+     */
+    bool getInterruptStatus(uint32_t &status_mask);
+
+    /**
+     * @brief Enable the interrupt pin of the chip, so that waiting functions block on it instead of polling the chip
+     *
+     * @note  The interrupt pin should be active low and open-drain, like the one of TCA95xx and HT8574.
+     *
+     * @param[in] int_io GPIO number connected to the interrupt pin
+     *
+     * @return true if success, otherwise false
+     */
+    bool enableInterrupt(int int_io);
+
+    /**
+     * @brief Disable the interrupt pin of the chip
+     *
+     * @return true if success, otherwise false
+     */
+    bool disableInterrupt(void);
+
+    /**
+     * @brief Set the interval of polling the chip in waiting functions when the interrupt pin isn't enabled
+     *
+     * @param[in] interval_ms Polling interval in milliseconds
+     *
+     * @return true if success, otherwise false
+     */
+    bool setPollInterval(uint32_t interval_ms);
+
+    /**
+     * @brief Block the calling task until the pin reaches the level
+     *
+     * @note  The chip is only read when its interrupt pin is asserted (see `enableInterrupt()`) or every polling
+     *        interval (see `setPollInterval()`), so this is much lighter on the bus than looping `digitalRead()`.
+     *
+     * @param[in] pin        Pin number (0-31)
+     * @param[in] value      Pin level to wait for (HIGH / LOW)
+     * @param[in] timeout_ms Maximum time to wait, `ESP_IO_EXPANDER_WAIT_FOREVER` means no timeout
+     *
+     * @return true if the pin reaches the level, false if timeout or failed
+     */
+    bool waitFor(uint8_t pin, uint8_t value, uint32_t timeout_ms = ESP_IO_EXPANDER_WAIT_FOREVER);
+
+    /**
+     * @brief Block the calling task until all the pins reach the level
+     *
+     * @param[in] pin_mask   Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in] value      Pin level to wait for (HIGH / LOW)
+     * @param[in] timeout_ms Maximum time to wait, `ESP_IO_EXPANDER_WAIT_FOREVER` means no timeout
+     *
+     * @return true if all the pins reach the level, false if timeout or failed
+     */
+    bool multiWaitFor(uint32_t pin_mask, uint8_t value, uint32_t timeout_ms = ESP_IO_EXPANDER_WAIT_FOREVER);
+
+    /**
+     * @brief Subscribe the input changes of the pins, delivered by a callback or a task notification
+     *
+     * @note  The changes are observed by the monitor task (see `startMonitor()`), or by calling `checkChanges()`.
+     *
+     * @param[in]  config        Subscription configuration, see `esp_io_expander_subscribe_config_t`
+     * @param[out] subscriber_id ID of the subscriber, used to unsubscribe
+     *
+     * @return true if success, otherwise false
+     */
+    bool subscribe(const esp_io_expander_subscribe_config_t &config, int &subscriber_id);
+
+    /**
+     * @brief Unsubscribe the input changes
+     *
+     * @param[in] subscriber_id ID got from `subscribe()`
+     *
+     * @return true if success, otherwise false
+     */
+    bool unsubscribe(int subscriber_id);
+
+    /**
+     * @brief Read the pins once and deliver the changes since the last read to the subscribers
+     *
+     * @return true if success, otherwise false
+     */
+    bool checkChanges(void);
+
+    /**
+     * @brief Start a task to check the input changes on interrupts (see `enableInterrupt()`) or by polling
+     *
+     * @param[in] config Monitor task configuration, see `esp_io_expander_monitor_config_t`
+     *
+     * @return true if success, otherwise false
+     */
+    bool startMonitor(const esp_io_expander_monitor_config_t &config);
+
+    /**
+     * @brief Start a task to check the input changes with the default configuration
+     *
+     * @return true if success, otherwise false
+     */
+    bool startMonitor(void);
+
+    /**
+     * @brief Stop the monitor task
+     *
+     * @return true if success, otherwise false
+     */
+    bool stopMonitor(void);
+
+    /**
+     * @brief Add a rule forcing output pins while input pins are at given levels, evaluated right where the input
+     *        changes are observed (e.g. in the monitor task), without going through any application task
+     *
+     * @param[in]  rule    Rule, see `esp_io_expander_rule_t`
+     * @param[out] rule_id ID of the rule, used to remove it
+     *
+     * @return true if success, otherwise false
+     */
+    bool addRule(const esp_io_expander_rule_t &rule, int &rule_id);
+
+    /**
+     * @brief Remove a rule, the pins forced only by it are restored to the levels set by users
+     *
+     * @param[in] rule_id ID got from `addRule()`
+     *
+     * @return true if success, otherwise false
+     */
+    bool removeRule(int rule_id);
+
+    /**
+     * @brief Get the statistics of the rules, including the reaction time
+     *
+     * @param[out] stats Statistics, see `esp_io_expander_rule_stats_t`
+     * @param[in]  reset Reset the statistics after getting them
+     *
+     * @return true if success, otherwise false
+     */
+    bool getRuleStats(esp_io_expander_rule_stats_t &stats, bool reset = false);
+
     /**
      * @brief Print IO expander status, include pin index, direction, input level and output level
      *
@@ -6,6 +6,7 @@
 
 #include "esp_expander_utils.h"
 #include "port/esp_io_expander_ch422g.h"
+#include "utils/esp_expander_segment_encoder.hpp"
 #include "esp_expander_ch422g.hpp"
 
 namespace esp_expander {
@@ -89,6 +90,40 @@ bool CH422G::enableAllIO_Input(void)
     return true;
 }
 
+bool CH422G::isInputReady(void)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    bool ready = false;
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_io_expander_ch422g_is_input_ready(device_handle, &ready), false, "Check failed");
+
+    return ready;
+}
+
+bool CH422G::setInputReadyCallback(std::function<void(void)> callback)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    // Detach the driver first, so the callback is never called while being replaced
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_ch422g_set_input_ready_callback(device_handle, nullptr, nullptr), false,
+        "Remove input ready callback failed"
+    );
+    _input_ready_callback = std::move(callback);
+    if (_input_ready_callback) {
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_io_expander_ch422g_set_input_ready_callback(device_handle, onInputReady, this), false,
+            "Set input ready callback failed"
+        );
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 bool CH422G::enableAllIO_Output(void)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -134,4 +169,93 @@ bool CH422G::exitSleep(void)
     return true;
 }
 
+bool CH422G::setAutoSleep(uint32_t idle_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_ch422g_set_auto_sleep(device_handle, idle_ms), false, "Set auto sleep failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool CH422G::getSleepStats(esp_io_expander_ch422g_sleep_stats_t &stats, bool reset)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_ch422g_get_sleep_stats(device_handle, &stats, reset), false, "Get sleep stats failed"
+    );
+
+    return true;
+}
+
+bool CH422G::enableDisplayScan(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_ch422g_enable_display_scan(device_handle), false, "Enable display scan failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool CH422G::disableDisplayScan(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_ch422g_disable_display_scan(device_handle), false, "Disable display scan failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool CH422G::writeDisplayDigits(uint8_t start_digit, const uint8_t *segments, size_t digit_num)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_ch422g_write_display_digits(device_handle, start_digit, segments, digit_num), false,
+        "Write display digits failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool CH422G::printDisplay(const char *text)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(text, false, "Invalid text");
+
+    uint8_t segments[ESP_IO_EXPANDER_CH422G_DISPLAY_DIGIT_NUM] = {};
+    SegmentEncoder::encodeText(text, segments, ESP_IO_EXPANDER_CH422G_DISPLAY_DIGIT_NUM);
+
+    return writeDisplayDigits(0, segments, ESP_IO_EXPANDER_CH422G_DISPLAY_DIGIT_NUM);
+}
+
+void CH422G::onInputReady(esp_io_expander_handle_t handle, void *user_ctx)
+{
+    CH422G *expander = static_cast<CH422G *>(user_ctx);
+
+    expander->_input_ready_callback();
+}
+
 } // namespace esp_expander
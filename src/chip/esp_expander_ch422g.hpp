@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <functional>
+#include "port/esp_io_expander_ch422g.h"
 #include "esp_expander_base.hpp"
 
 namespace esp_expander {
@@ -88,11 +90,32 @@ public:
      * @note  The driver initialization by default sets CH422G's IO0-7 to output high-level mode.
      * @note  Since the input/output mode of CH422G's IO0-7 must remain consistent, the driver will only set IO0-7 to
      *        input mode when it determines that all pins are configured as input.
+     * @note  This function doesn't wait for IO0-7 to settle (about 2ms), the next read waits for the remaining time if it
+     *        comes too early. See `isInputReady()` and `setInputReadyCallback()`.
      *
      * @return true if success, otherwise false
      */
     bool enableAllIO_Input(void);
 
+    /**
+     * @brief Check whether IO0-7 are in input mode and settled, so that reading them doesn't wait
+     *
+     * @return true if ready, otherwise false
+     */
+    bool isInputReady(void);
+
+    /**
+     * @brief Set the callback called each time IO0-7 are ready to be read after switching to input mode
+     *
+     * @note  The callback is called from the `esp_timer` task and should return quickly.
+     * @note  Once this function returns, the previous callback is no longer running or called.
+     *
+     * @param[in] callback Callback, empty to remove
+     *
+     * @return true if success, otherwise false
+     */
+    bool setInputReadyCallback(std::function<void(void)> callback);
+
     /**
      * @brief Enable IO0-7 output mode
      *
@@ -113,6 +136,74 @@ public:
      * @return true if success, otherwise false
      */
     bool exitSleep(void);
+
+    /**
+     * @brief Enable the auto sleep, the chip enters sleep after being idle for the time and is woken transparently by
+     *        the next access, which takes one more I2C transaction
+     *
+     * @note  Should be called before the object is accessed from other tasks.
+     *
+     * @param[in] idle_ms Idle time before entering sleep, 0 to disable and wake the chip
+     *
+     * @return true if success, otherwise false
+     */
+    bool setAutoSleep(uint32_t idle_ms);
+
+    /**
+     * @brief Get the statistics of the auto sleep, including the latency added by waking
+     *
+     * @param[out] stats Statistics, see `esp_io_expander_ch422g_sleep_stats_t`
+     * @param[in]  reset Reset the statistics after getting them
+     *
+     * @return true if success, otherwise false
+     */
+    bool getSleepStats(esp_io_expander_ch422g_sleep_stats_t &stats, bool reset = false);
+
+    /**
+     * @brief Enable the display scan mode, the chip multiplexes up to 4 digits of LED display by itself, without any
+     *        further I2C traffic
+     *
+     * @note  IO0-7 drive the segments (a-g, dp) and OC0-3 drive the common pins of DIG0-3. All digits are blanked.
+     * @note  IO0-7 and OC0-3 can't be written by `digitalWrite()` until the mode is disabled.
+     *
+     * @return true if success, otherwise false
+     */
+    bool enableDisplayScan(void);
+
+    /**
+     * @brief Disable the display scan mode, IO0-7 output the segments of DIG0
+     *
+     * @return true if success, otherwise false
+     */
+    bool disableDisplayScan(void);
+
+    /**
+     * @brief Write the segments of continuous digits, only the changed digits are sent
+     *
+     * @param[in] start_digit Index of the first digit (0-3)
+     * @param[in] segments    Segments of each digit, bit `n` is IOn
+     * @param[in] digit_num   Number of digits
+     *
+     * @return true if success, otherwise false
+     */
+    bool writeDisplayDigits(uint8_t start_digit, const uint8_t *segments, size_t digit_num);
+
+    /**
+     * @brief Show a string on the 7-segment digits from DIG0, the remaining digits are cleared
+     *
+     * @note  The characters are encoded by `SegmentEncoder::encodeChar()`. A '.' is merged into the decimal point of
+     *        the previous character, e.g. "12.34" takes 4 digits.
+     *
+     * @param[in] text String
+     *
+     * @return true if success, otherwise false
+     */
+    bool printDisplay(const char *text);
+
+private:
+    static void onInputReady(esp_io_expander_handle_t handle, void *user_ctx);
+
+    std::function<void(void)> _input_ready_callback;
 };
 
 } // namespace esp_expander
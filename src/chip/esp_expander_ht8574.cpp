@@ -44,4 +44,35 @@ bool HT8574::begin(void)
     return true;
 }
 
+bool HT8574::readInputBurst(uint8_t *samples, size_t count)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_ht8574_read_input_burst(device_handle, samples, count), false, "Burst read input failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool HT8574::readInputMajority(size_t sample_num, uint8_t &levels)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_ht8574_read_input_majority(device_handle, sample_num, &levels), false,
+        "Majority read input failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 } // namespace esp_expander
@@ -63,6 +63,29 @@ public:
      * @return true if success, otherwise false
      */
     bool begin(void) override;
+
+    /**
+     * @brief Read consecutive snapshots of all pins in a single I2C read transaction
+     *
+     * @note  The chip samples the port again for every byte clocked out, so this captures the pins at the bus speed.
+     *
+     * @param[out] samples Array to store the snapshots, every bit represents a pin (HIGH / LOW)
+     * @param[in]  count   Number of snapshots to read
+     *
+     * @return true if success, otherwise false
+     */
+    bool readInputBurst(uint8_t *samples, size_t count);
+
+    /**
+     * @brief Read all pins by burst sampling and take the majority level of each pin
+     *
+     * @param[in]  sample_num Number of snapshots, should be odd and in
+     *                        [1, `ESP_IO_EXPANDER_HT8574_MAJORITY_SAMPLES_MAX`]
+     * @param[out] levels     Filtered levels, every bit represents a pin (HIGH / LOW)
+     *
+     * @return true if success, otherwise false
+     */
+    bool readInputMajority(size_t sample_num, uint8_t &levels);
 };
 
 } // namespace esp_expander
@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_expander_utils.h"
+#include "port/esp_io_expander_mcp23x17.h"
+#include "esp_expander_mcp23017.hpp"
+
+namespace esp_expander {
+
+MCP23017::~MCP23017()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool MCP23017::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::BEGIN), false, "Already begun");
+
+    // Initialize the bus if not initialized
+    if (!isOverState(State::INIT)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(init(), false, "Init failed");
+    }
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_new_i2c_mcp23017(
+            static_cast<i2c_port_t>(getConfig().host_id), getConfig().device.address, &device_handle
+        ), false, "Create MCP23017 failed"
+    );
+    ESP_UTILS_LOGD("Create MCP23017 @%p", device_handle);
+
+    setState(State::BEGIN);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+} // namespace esp_expander
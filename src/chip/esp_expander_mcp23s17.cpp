@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_expander_utils.h"
+#include "port/esp_io_expander_mcp23x17.h"
+#include "esp_expander_mcp23s17.hpp"
+
+namespace esp_expander {
+
+MCP23S17::~MCP23S17()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool MCP23S17::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::BEGIN), false, "Already begun");
+
+    // No I2C host config, so this only updates the state
+    if (!isOverState(State::INIT)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(init(), false, "Init failed");
+    }
+
+    const esp_io_expander_mcp23s17_spi_config_t spi_config = {
+        .cs_io_num = _cs_io,
+        .clk_speed_hz = _clk_speed,
+        .hw_address = getConfig().device.address,
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_new_spi_mcp23s17(
+            static_cast<spi_host_device_t>(getConfig().host_id), &spi_config, &device_handle
+        ), false, "Create MCP23S17 failed"
+    );
+    ESP_UTILS_LOGD("Create MCP23S17 @%p", device_handle);
+
+    setState(State::BEGIN);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+} // namespace esp_expander
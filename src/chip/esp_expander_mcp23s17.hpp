@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "port/esp_io_expander_mcp23x17.h"
+#include "esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The MCP23S17 IO expander device class, which is on SPI instead of I2C
+ *
+ * @note  This class is a derived class of `esp_expander::Base`, user can use it directly
+ * @note  The SPI bus should be initialized by `spi_bus_initialize()` before calling `begin()`, `init()` doesn't
+ *        initialize any bus. In the configuration got from `getConfig()`, `host_id` is the SPI host and
+ *        `device.address` is the hardware address.
+ * @note  The pull-ups and interrupt mask are supported by `INPUT_PULLUP` and the `multiSet*()` functions of
+ *        `esp_expander::Base`
+ */
+class MCP23S17: public Base {
+public:
+    constexpr static int SPI_CLK_SPEED_DEFAULT = ESP_IO_EXPANDER_MCP23S17_SPI_CLK_SPEED_DEFAULT;
+
+    /**
+     * @brief Construct a MCP23S17 device
+     *
+     * @param[in] host_id    SPI host ID, the bus should be initialized by users
+     * @param[in] cs_io      SPI CS pin number
+     * @param[in] hw_address Hardware address (0-7) set by A2-A0 pins, several chips can share a CS pin
+     * @param[in] clk_speed  SPI clock speed in Hz, up to 10MHz
+     */
+    MCP23S17(int host_id, int cs_io, uint8_t hw_address = 0, int clk_speed = SPI_CLK_SPEED_DEFAULT):
+        Base(host_id, hw_address),
+        _cs_io(cs_io),
+        _clk_speed(clk_speed)
+    {
+    }
+
+    /**
+     * @brief Desutruct object. This function will call `del()` to delete the object.
+     */
+    ~MCP23S17() override;
+
+    /**
+     * @brief Begin object
+     *
+     * @note  This function calls `esp_io_expander_new_spi_mcp23s17()` to add the device to the SPI bus and create the
+     *        IO expander handle.
+     * @note  This function sets all pins to inpurt mode by default.
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void) override;
+
+private:
+    int _cs_io;
+    int _clk_speed;
+};
+
+} // namespace esp_expander
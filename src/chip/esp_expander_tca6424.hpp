@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The TCA6424 (TCA6424A, 24 pins) IO expander device class
+ *
+ * @note  This class is a derived class of `esp_expander::Base`, user can use it directly
+ * @note  All ports of a register are read or written in a single I2C transaction
+ */
+class TCA6424: public Base {
+public:
+    /**
+     * @brief Construct a TCA6424 device. With this function, call `init()` will initialize I2C by using the host
+     *        configuration.
+     *
+     * @param[in] scl_io  I2C SCL pin number
+     * @param[in] sda_io  I2C SDA pin number
+     * @param[in] address I2C device 7-bit address. Should be like `ESP_IO_EXPANDER_I2C_<chip name>_ADDRESS`.
+     */
+    TCA6424(int scl_io, int sda_io, uint8_t address): Base(scl_io, sda_io, address) {}
+
+    /**
+     * @brief Construct a TCA6424 device. With this function, call `init()` will not initialize I2C, and users
+     *        should initialize it manually.
+     *
+     * @param[in] host_id I2C host ID.
+     * @param[in] address I2C device 7-bit address. Should be like `ESP_IO_EXPANDER_I2C_<chip name>_ADDRESS`.
+     */
+    TCA6424(int host_id, uint8_t address): Base(host_id, address) {}
+
+    /**
+     * @brief Construct a TCA6424 device.
+     *
+     * @param[in] config Configuration for the object
+     */
+    TCA6424(const Config &config): Base(config) {}
+
+    /**
+     * @brief Desutruct object. This function will call `del()` to delete the object.
+     */
+    ~TCA6424() override;
+
+    /**
+     * @brief Begin object
+     *
+     * @note  This function typically calls `esp_io_expander_new_i2c_*()` to create the IO expander handle.
+     * @note  This function sets all pins to inpurt mode by default.
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void) override;
+};
+
+} // namespace esp_expander
@@ -44,4 +44,20 @@ bool TCA95XX_16BIT::begin(void)
     return true;
 }
 
+bool TCA95XX_16BIT::writeConfig(uint16_t output, uint16_t polarity, uint16_t direction)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_tca95xx_16bit_write_config(device_handle, output, polarity, direction), false,
+        "Write config failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 } // namespace esp_expander
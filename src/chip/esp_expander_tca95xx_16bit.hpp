@@ -63,6 +63,20 @@ public:
      * @return true if success, otherwise false
      */
     bool begin(void) override;
+
+    /**
+     * @brief Write the output, polarity inversion and configuration registers of both ports in a single I2C
+     *        transaction
+     *
+     * @note  The values are written to the registers as they are, the output is written before the configuration.
+     *
+     * @param[in] output    Output levels, bit `n` is pin `n`
+     * @param[in] polarity  Polarity inversion of inputs, 1 means inverted
+     * @param[in] direction Configuration, 1 means input and 0 means output
+     *
+     * @return true if success, otherwise false
+     */
+    bool writeConfig(uint16_t output, uint16_t polarity, uint16_t direction);
 };
 
 } // namespace esp_expander
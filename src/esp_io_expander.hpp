@@ -8,14 +8,38 @@
 
 /* Porting drivers */
 #include "port/esp_io_expander.h"
+#include "port/esp_io_expander_aw9523b.h"
 #include "port/esp_io_expander_ch422g.h"
 #include "port/esp_io_expander_ht8574.h"
+#include "port/esp_io_expander_mcp23x17.h"
+#include "port/esp_io_expander_pcal95xx.h"
+#include "port/esp_io_expander_tca6424.h"
 #include "port/esp_io_expander_tca9554.h"
 #include "port/esp_io_expander_tca95xx_16bit.h"
 
 /* Wrapper classes */
 #include "chip/esp_expander_base.hpp"
+#include "chip/esp_expander_aw9523b.hpp"
 #include "chip/esp_expander_ch422g.hpp"
 #include "chip/esp_expander_ht8574.hpp"
+#include "chip/esp_expander_mcp23017.hpp"
+#include "chip/esp_expander_mcp23s17.hpp"
+#include "chip/esp_expander_pcal95xx_8bit.hpp"
+#include "chip/esp_expander_pcal95xx_16bit.hpp"
+#include "chip/esp_expander_tca6424.hpp"
 #include "chip/esp_expander_tca95xx_8bit.hpp"
 #include "chip/esp_expander_tca95xx_16bit.hpp"
+
+/* Utilities */
+#include "utils/esp_expander_segment_encoder.hpp"
+
+/* Services */
+#include "service/esp_expander_keypad.hpp"
+#include "service/esp_expander_input_sampler.hpp"
+#include "service/esp_expander_pwm.hpp"
+#include "service/esp_expander_timeline.hpp"
+#include "service/esp_expander_spi_3wire.hpp"
+#include "service/esp_expander_shift_register.hpp"
+#include "service/esp_expander_hd44780.hpp"
+#include "service/esp_expander_segment_display.hpp"
+#include "service/esp_expander_stepper.hpp"
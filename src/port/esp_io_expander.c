@@ -6,16 +6,30 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "driver/gpio.h"
+#include "esp_attr.h"
 #include "esp_bit_defs.h"
 #include "esp_check.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 
 #include "esp_io_expander.h"
 
 #include "esp_expander_utils.h"
 
 #define VALID_IO_COUNT(handle)      ((handle)->config.io_count <= IO_COUNT_MAX ? (handle)->config.io_count : IO_COUNT_MAX)
+#define VALID_PIN_MASK(handle)      ((uint32_t)(BIT64(VALID_IO_COUNT(handle)) - 1))
+
+#define LUT_LANE_BITS               (8)
+#define LUT_LANE_SIZE               (1 << LUT_LANE_BITS)
+#define MONITOR_STOP_WAIT_MS        (100)
+#define STREAM_STACK_VALUE_NUM      (16)
+#define INPUT_PORT_IO_COUNT         (8)     /* IOs of each input register, read and cleared as a whole */
 
 /**
  * @brief Register type
@@ -26,10 +40,106 @@ typedef enum {
     REG_DIRECTION,
 } reg_type_t;
 
+/**
+ * @brief Task waiting for input changes, linked in the runtime data
+ */
+typedef struct waiter_s {
+    SemaphoreHandle_t sem;
+    StaticSemaphore_t sem_buf;
+    struct waiter_s *next;
+} waiter_t;
+
+/**
+ * @brief Subscriber of input changes
+ */
+typedef struct {
+    esp_io_expander_subscribe_config_t config;
+} subscriber_t;
+
+struct esp_io_expander_runtime_s {
+    portMUX_TYPE lock;
+    int int_gpio_num;
+    uint32_t poll_interval_ms;
+    waiter_t *waiters;
+    /* Subscription registry, protected by `sub_mutex` */
+    SemaphoreHandle_t sub_mutex;
+    subscriber_t subscribers[ESP_IO_EXPANDER_SUBSCRIBER_NUM_MAX];
+    uint32_t subscriber_used_mask;
+    uint32_t (*lut)[LUT_LANE_SIZE];     /* [lane][changed bits of the lane] -> subscribers watching any of them */
+    uint8_t lut_lane_num;
+    uint32_t last_level_mask;
+    bool last_level_valid;
+    /* Input-to-output rules, protected by `sub_mutex`, which also serializes the writes of the output register */
+    esp_io_expander_rule_t rules[ESP_IO_EXPANDER_RULE_NUM_MAX];
+    uint32_t rule_used_mask;
+    uint32_t forced_mask;               /* Output IOs forced by the active rules */
+    uint32_t forced_level_mask;         /* Levels of the forced IOs, 1 - High level */
+    uint32_t user_level_mask;           /* Levels set by users to the forced IOs, restored once released */
+    int64_t int_timestamp_us;           /* Time of the first interrupt not handled yet, 0 if none */
+    esp_io_expander_rule_stats_t rule_stats;
+    uint64_t reaction_time_total_us;
+    uint32_t open_drain_mask;           /* IOs in emulated open-drain mode */
+    uint32_t int_disabled_mask;         /* IOs whose interrupt is disabled, all enabled by the drivers on reset */
+    /* Monitor task */
+    TaskHandle_t monitor_task;
+    volatile bool monitor_running;
+};
+
 static const char *TAG = "io_expander";
 
 static esp_err_t write_reg(esp_io_expander_handle_t handle, reg_type_t reg, uint32_t value);
 static esp_err_t read_reg(esp_io_expander_handle_t handle, reg_type_t reg, uint32_t *value);
+static esp_io_expander_runtime_t *get_runtime(esp_io_expander_handle_t handle);
+static void free_runtime(esp_io_expander_handle_t handle);
+static void notify_waiters(esp_io_expander_runtime_t *runtime);
+static void int_isr_handler(void *arg);
+static void rebuild_lut(esp_io_expander_runtime_t *runtime);
+static void dispatch_changes(esp_io_expander_handle_t handle, uint32_t old_level_mask, uint32_t new_level_mask);
+static void monitor_task(void *arg);
+static esp_err_t apply_rules(esp_io_expander_handle_t handle, uint32_t level_mask, int64_t observed_us);
+
+/**
+ * @brief Get the output IOs forced by the rules, which can't be changed by users, should be called with the output
+ *        locked by `lock_output()`
+ */
+static inline uint32_t get_forced_mask(esp_io_expander_runtime_t *runtime)
+{
+    return runtime ? runtime->forced_mask : 0;
+}
+
+/**
+ * @brief Get the IOs in emulated open-drain mode, whose output register can't be written by the output functions,
+ *        should be called with the output locked by `lock_output()`
+ */
+static inline uint32_t get_open_drain_mask(esp_io_expander_runtime_t *runtime)
+{
+    return runtime ? runtime->open_drain_mask : 0;
+}
+
+/**
+ * @brief Lock the output register against the rules applied by the monitor task, nothing to lock without runtime
+ *
+ * @return
+ *      - Runtime data to pass to `unlock_output()`, NULL if not locked
+ */
+static inline esp_io_expander_runtime_t *lock_output(esp_io_expander_handle_t handle)
+{
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+    if (runtime) {
+        xSemaphoreTakeRecursive(runtime->sub_mutex, portMAX_DELAY);
+    }
+    return runtime;
+}
+
+/**
+ * @brief Unlock the output register locked by `lock_output()`
+ */
+static inline void unlock_output(esp_io_expander_runtime_t *runtime)
+{
+    if (runtime) {
+        xSemaphoreGiveRecursive(runtime->sub_mutex);
+    }
+}
 
 esp_err_t esp_io_expander_set_dir(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_dir_t direction)
 {
@@ -38,9 +148,12 @@ esp_err_t esp_io_expander_set_dir(esp_io_expander_handle_t handle, uint32_t pin_
         ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
     }
 
+    /* The open-drain mode is quit under the lock, so it can't be changed meanwhile by other output functions */
+    esp_io_expander_runtime_t *runtime = lock_output(handle);
+    esp_err_t ret = ESP_OK;
     bool is_output = (direction == IO_EXPANDER_OUTPUT) ? true : false;
     uint32_t dir_reg, temp;
-    ESP_RETURN_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), TAG, "Read direction reg failed");
+    ESP_GOTO_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), end, TAG, "Read direction reg failed");
     temp = dir_reg;
     if ((is_output && !handle->config.flags.dir_out_bit_zero) || (!is_output && handle->config.flags.dir_out_bit_zero)) {
         /* 1. Output && Set 1 to output */
@@ -53,10 +166,111 @@ esp_err_t esp_io_expander_set_dir(esp_io_expander_handle_t handle, uint32_t pin_
     }
     /* Write to reg only when different */
     if (dir_reg != temp) {
-        ESP_RETURN_ON_ERROR(write_reg(handle, REG_DIRECTION, dir_reg), TAG, "Write direction reg failed");
+        ESP_GOTO_ON_ERROR(write_reg(handle, REG_DIRECTION, dir_reg), end, TAG, "Write direction reg failed");
+    }
+    if (runtime) {
+        runtime->open_drain_mask &= ~pin_num_mask;
     }
 
-    return ESP_OK;
+end:
+    unlock_output(runtime);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_set_open_drain(esp_io_expander_handle_t handle, uint32_t pin_num_mask)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(!handle->config.flags.dir_shared, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Direction can't be set for each IO");
+    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+
+    lock_output(handle);
+    esp_err_t ret = ESP_OK;
+    /* The levels of the forced IOs would be restored to the output register once released */
+    ESP_GOTO_ON_FALSE(
+        (pin_num_mask & runtime->forced_mask) == 0, ESP_ERR_INVALID_STATE, end, TAG,
+        "Pin mask(0x%" PRIx32 ") is forced by the rules", pin_num_mask & runtime->forced_mask
+    );
+
+    uint32_t output_reg, dir_reg;
+    ESP_GOTO_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), end, TAG, "Read output reg failed");
+    ESP_GOTO_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), end, TAG, "Read direction reg failed");
+    /* Get 1 if output high level */
+    uint32_t output_invert_mask = handle->config.flags.output_high_bit_zero ? 0xffffffff : 0;
+    /* Get 1 if output */
+    uint32_t dir_invert_mask = handle->config.flags.dir_out_bit_zero ? 0xffffffff : 0;
+    uint32_t new_output_reg = output_reg ^ output_invert_mask;
+    uint32_t new_dir_reg = dir_reg ^ dir_invert_mask;
+
+    if (handle->config.flags.output_quasi_bidirectional) {
+        /* The high level is a weak pull-up, so the IOs are released by outputting high level */
+        new_output_reg = (new_output_reg | pin_num_mask) ^ output_invert_mask;
+        new_dir_reg = (new_dir_reg | pin_num_mask) ^ dir_invert_mask;
+        if (new_output_reg != output_reg) {
+            ESP_GOTO_ON_ERROR(write_reg(handle, REG_OUTPUT, new_output_reg), end, TAG, "Write output reg failed");
+        }
+        if (new_dir_reg != dir_reg) {
+            ESP_GOTO_ON_ERROR(write_reg(handle, REG_DIRECTION, new_dir_reg), end, TAG, "Write direction reg failed");
+        }
+    } else {
+        /* Release the IOs before latching low level, so the lines are never driven high or low meanwhile */
+        new_dir_reg = (new_dir_reg & ~pin_num_mask) ^ dir_invert_mask;
+        new_output_reg = (new_output_reg & ~pin_num_mask) ^ output_invert_mask;
+        if (new_dir_reg != dir_reg) {
+            ESP_GOTO_ON_ERROR(write_reg(handle, REG_DIRECTION, new_dir_reg), end, TAG, "Write direction reg failed");
+        }
+        if (new_output_reg != output_reg) {
+            ESP_GOTO_ON_ERROR(write_reg(handle, REG_OUTPUT, new_output_reg), end, TAG, "Write output reg failed");
+        }
+    }
+    runtime->open_drain_mask |= pin_num_mask;
+
+end:
+    unlock_output(runtime);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_set_open_drain_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    /* The open-drain mode is checked and the register is written under the lock of the output */
+    esp_io_expander_runtime_t *runtime = lock_output(handle);
+    esp_err_t ret = ESP_OK;
+    uint32_t open_drain_mask = get_open_drain_mask(runtime);
+    ESP_GOTO_ON_FALSE(
+        (pin_num_mask & ~open_drain_mask) == 0, ESP_ERR_INVALID_STATE, end, TAG,
+        "Pin mask(0x%" PRIx32 ") isn't in open-drain mode", pin_num_mask & ~open_drain_mask
+    );
+
+    /* Only a single register is written, the output register of push-pull devices keeps low level */
+    reg_type_t reg = handle->config.flags.output_quasi_bidirectional ? REG_OUTPUT : REG_DIRECTION;
+    uint32_t reg_value;
+    ESP_GOTO_ON_ERROR(read_reg(handle, reg, &reg_value), end, TAG, "Read reg failed");
+    /* Get 1 if released, which is high level for the output register and input mode for the direction register */
+    uint32_t invert_mask = 0;
+    if (reg == REG_OUTPUT) {
+        invert_mask = handle->config.flags.output_high_bit_zero ? 0xffffffff : 0;
+    } else {
+        invert_mask = handle->config.flags.dir_out_bit_zero ? 0 : 0xffffffff;
+    }
+    uint32_t released = reg_value ^ invert_mask;
+    released = level ? (released | pin_num_mask) : (released & ~pin_num_mask);
+    if ((released ^ invert_mask) != reg_value) {
+        ESP_GOTO_ON_ERROR(write_reg(handle, reg, released ^ invert_mask), end, TAG, "Write reg failed");
+    }
+
+end:
+    unlock_output(runtime);
+
+    return ret;
 }
 
 esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level)
@@ -66,8 +280,25 @@ esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pi
         ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
     }
 
+    /* The forced IOs and the output register are checked and written under the lock of the rules */
+    esp_io_expander_runtime_t *runtime = lock_output(handle);
+    esp_err_t ret = ESP_OK;
+
+    /* The IOs in open-drain mode are asserted or released */
+    uint32_t open_drain_mask = pin_num_mask & get_open_drain_mask(runtime);
+    if (open_drain_mask) {
+        ESP_GOTO_ON_ERROR(
+            esp_io_expander_set_open_drain_level(handle, open_drain_mask, level), end, TAG,
+            "Set open-drain level failed"
+        );
+        pin_num_mask &= ~open_drain_mask;
+        if (!pin_num_mask) {
+            goto end;
+        }
+    }
+
     uint32_t dir_reg, dir_bit;
-    ESP_RETURN_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), TAG, "Read direction reg failed");
+    ESP_GOTO_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), end, TAG, "Read direction reg failed");
 
     uint8_t io_count = VALID_IO_COUNT(handle);
     /* Check every target pin's direction, must be in output mode */
@@ -79,14 +310,26 @@ esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pi
                 /* 1. 1 && Set 1 to input */
                 /* 2. 0 && Set 0 to input */
                 ESP_LOGE(TAG, "Pin[%d] can't set level in input mode", i);
-                return ESP_ERR_INVALID_STATE;
+                ret = ESP_ERR_INVALID_STATE;
+                goto end;
             }
         }
     }
 
+    /* The IOs forced by the rules keep their levels, the requested ones are applied once released */
+    uint32_t forced_mask = pin_num_mask & get_forced_mask(runtime);
+    if (forced_mask) {
+        if (level) {
+            runtime->user_level_mask |= forced_mask;
+        } else {
+            runtime->user_level_mask &= ~forced_mask;
+        }
+        pin_num_mask &= ~forced_mask;
+    }
+
     uint32_t output_reg, temp;
     /* Read the current output level */
-    ESP_RETURN_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), TAG, "Read Output reg failed");
+    ESP_GOTO_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), end, TAG, "Read Output reg failed");
     temp = output_reg;
     /* Set expected output level */
     if ((level && !handle->config.flags.output_high_bit_zero) || (!level && handle->config.flags.output_high_bit_zero)) {
@@ -100,10 +343,50 @@ esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pi
     }
     /* Write to reg only when different */
     if (output_reg != temp) {
-        ESP_RETURN_ON_ERROR(write_reg(handle, REG_OUTPUT, output_reg), TAG, "Write Output reg failed");
+        ESP_GOTO_ON_ERROR(write_reg(handle, REG_OUTPUT, output_reg), end, TAG, "Write Output reg failed");
     }
 
-    return ESP_OK;
+end:
+    unlock_output(runtime);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_set_output(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t level_mask)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    /* No direction check here, the IOs forced by the rules are already in output mode and keep their levels */
+    esp_io_expander_runtime_t *runtime = lock_output(handle);
+    esp_err_t ret = ESP_OK;
+    /* The IOs in open-drain mode are left untouched, their output register must keep low level */
+    pin_num_mask &= ~get_open_drain_mask(runtime);
+    uint32_t forced_mask = pin_num_mask & get_forced_mask(runtime);
+    if (forced_mask) {
+        runtime->user_level_mask = (runtime->user_level_mask & ~forced_mask) | (level_mask & forced_mask);
+    }
+    uint32_t set_pin_num_mask = pin_num_mask & ~forced_mask;
+    uint32_t output_reg, temp;
+    ESP_GOTO_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), end, TAG, "Read output reg failed");
+    temp = output_reg;
+    /* Get 1 if output high level */
+    if (handle->config.flags.output_high_bit_zero) {
+        level_mask ^= 0xffffffff;
+    }
+    output_reg = (output_reg & ~set_pin_num_mask) | (level_mask & set_pin_num_mask);
+    /* Write to reg only when different */
+    if (output_reg != temp) {
+        ESP_GOTO_ON_ERROR(write_reg(handle, REG_OUTPUT, output_reg), end, TAG, "Write output reg failed");
+    }
+    ESP_GOTO_ON_ERROR(esp_io_expander_set_dir(handle, pin_num_mask, IO_EXPANDER_OUTPUT), end, TAG, "Set dir failed");
+
+end:
+    unlock_output(runtime);
+
+    return ret;
 }
 
 esp_err_t esp_io_expander_get_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *level_mask)
@@ -115,7 +398,13 @@ esp_err_t esp_io_expander_get_level(esp_io_expander_handle_t handle, uint32_t pi
     }
 
     uint32_t input_reg;
-    ESP_RETURN_ON_ERROR(read_reg(handle, REG_INPUT, &input_reg), TAG, "Read input reg failed");
+    if (handle->read_input_reg_masked) {
+        ESP_RETURN_ON_ERROR(
+            handle->read_input_reg_masked(handle, pin_num_mask, &input_reg), TAG, "Read input reg failed"
+        );
+    } else {
+        ESP_RETURN_ON_ERROR(read_reg(handle, REG_INPUT, &input_reg), TAG, "Read input reg failed");
+    }
     if (!handle->config.flags.input_high_bit_zero) {
         /* Get 1 when input high level */
         *level_mask = input_reg & pin_num_mask;
@@ -127,6 +416,594 @@ esp_err_t esp_io_expander_get_level(esp_io_expander_handle_t handle, uint32_t pi
     return ESP_OK;
 }
 
+esp_err_t esp_io_expander_exchange_level(esp_io_expander_handle_t handle, uint32_t set_pin_num_mask,
+        uint32_t set_level_mask, uint32_t get_pin_num_mask, uint32_t *get_level_mask)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(get_level_mask, ESP_ERR_INVALID_ARG, TAG, "Invalid level");
+    if ((set_pin_num_mask | get_pin_num_mask) >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    uint32_t dir_reg;
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), TAG, "Read direction reg failed");
+    /* Get 1 if output, then check all target pins at once */
+    if (handle->config.flags.dir_out_bit_zero) {
+        dir_reg ^= 0xffffffff;
+    }
+    ESP_RETURN_ON_FALSE(
+        (set_pin_num_mask & ~dir_reg) == 0, ESP_ERR_INVALID_STATE, TAG,
+        "Pin mask(0x%" PRIx32 ") can't set level in input mode", set_pin_num_mask & ~dir_reg
+    );
+
+    /* The forced IOs and the output register are checked and written under the lock of the rules */
+    esp_io_expander_runtime_t *runtime = lock_output(handle);
+    esp_err_t ret = ESP_OK;
+    set_pin_num_mask &= ~(get_forced_mask(runtime) | get_open_drain_mask(runtime));
+
+    uint32_t output_reg;
+    ESP_GOTO_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), end, TAG, "Read output reg failed");
+    /* Get 1 if output high level */
+    if (handle->config.flags.output_high_bit_zero) {
+        set_level_mask ^= 0xffffffff;
+    }
+    output_reg = (output_reg & ~set_pin_num_mask) | (set_level_mask & set_pin_num_mask);
+
+    uint32_t input_reg;
+    if (handle->write_output_read_input) {
+        ESP_GOTO_ON_ERROR(
+            handle->write_output_read_input(handle, output_reg, &input_reg), end, TAG,
+            "Write output & read input reg failed"
+        );
+    } else {
+        ESP_GOTO_ON_ERROR(write_reg(handle, REG_OUTPUT, output_reg), end, TAG, "Write output reg failed");
+        ESP_GOTO_ON_ERROR(read_reg(handle, REG_INPUT, &input_reg), end, TAG, "Read input reg failed");
+    }
+    /* Get 1 if input high level */
+    if (handle->config.flags.input_high_bit_zero) {
+        input_reg ^= 0xffffffff;
+    }
+    *get_level_mask = input_reg & get_pin_num_mask;
+
+end:
+    unlock_output(runtime);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_write_output_stream(esp_io_expander_handle_t handle, uint32_t pin_num_mask,
+        const uint32_t *level_masks, size_t count)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(level_masks && count, ESP_ERR_INVALID_ARG, TAG, "Invalid level masks");
+    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    uint32_t dir_reg;
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), TAG, "Read direction reg failed");
+    /* Get 1 if output, then check all target pins at once */
+    if (handle->config.flags.dir_out_bit_zero) {
+        dir_reg ^= 0xffffffff;
+    }
+    ESP_RETURN_ON_FALSE(
+        (pin_num_mask & ~dir_reg) == 0, ESP_ERR_INVALID_STATE, TAG,
+        "Pin mask(0x%" PRIx32 ") can't set level in input mode", pin_num_mask & ~dir_reg
+    );
+
+    /* The forced IOs and the output register are checked and written under the lock of the rules */
+    esp_io_expander_runtime_t *runtime = lock_output(handle);
+    esp_err_t ret = ESP_OK;
+    uint32_t stack_values[STREAM_STACK_VALUE_NUM];
+    uint32_t *values = stack_values;
+    pin_num_mask &= ~(get_forced_mask(runtime) | get_open_drain_mask(runtime));
+
+    uint32_t output_reg;
+    ESP_GOTO_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), end, TAG, "Read output reg failed");
+    /* Get 1 if output high level */
+    uint32_t invert_mask = handle->config.flags.output_high_bit_zero ? 0xffffffff : 0;
+
+    if (!handle->write_output_stream) {
+        for (size_t i = 0; i < count; i++) {
+            output_reg = (output_reg & ~pin_num_mask) | ((level_masks[i] ^ invert_mask) & pin_num_mask);
+            ESP_GOTO_ON_ERROR(write_reg(handle, REG_OUTPUT, output_reg), end, TAG, "Write output reg failed");
+        }
+        goto end;
+    }
+
+    /* Convert the levels to the register values, short sequences don't need the heap */
+    if (count > STREAM_STACK_VALUE_NUM) {
+        values = (uint32_t *)malloc(count * sizeof(uint32_t));
+        ESP_GOTO_ON_FALSE(values, ESP_ERR_NO_MEM, end, TAG, "Malloc stream values failed");
+    }
+    for (size_t i = 0; i < count; i++) {
+        output_reg = (output_reg & ~pin_num_mask) | ((level_masks[i] ^ invert_mask) & pin_num_mask);
+        values[i] = output_reg;
+    }
+    ret = handle->write_output_stream(handle, values, count);
+    if (values != stack_values) {
+        free(values);
+    }
+    ESP_GOTO_ON_ERROR(ret, end, TAG, "Write output stream failed");
+
+end:
+    unlock_output(runtime);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_set_pull(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_pull_t pull)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(pull <= IO_EXPANDER_PULL_DOWN, ESP_ERR_INVALID_ARG, TAG, "Invalid pull");
+    ESP_RETURN_ON_FALSE(handle->set_pull, ESP_ERR_NOT_SUPPORTED, TAG, "Pull resistor not supported");
+    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    ESP_RETURN_ON_ERROR(handle->set_pull(handle, pin_num_mask, pull), TAG, "Set pull failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_set_drive(esp_io_expander_handle_t handle, uint32_t pin_num_mask,
+                                    esp_io_expander_drive_t drive)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(drive <= IO_EXPANDER_DRIVE_1X, ESP_ERR_INVALID_ARG, TAG, "Invalid drive");
+    ESP_RETURN_ON_FALSE(handle->set_drive, ESP_ERR_NOT_SUPPORTED, TAG, "Drive strength not supported");
+    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    ESP_RETURN_ON_ERROR(handle->set_drive(handle, pin_num_mask, drive), TAG, "Set drive failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_set_input_latch(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(handle->set_input_latch, ESP_ERR_NOT_SUPPORTED, TAG, "Input latch not supported");
+    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    ESP_RETURN_ON_ERROR(handle->set_input_latch(handle, pin_num_mask, enable), TAG, "Set input latch failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_set_int_enable(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(handle->set_int_enable, ESP_ERR_NOT_SUPPORTED, TAG, "Interrupt mask not supported");
+    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+
+    ESP_RETURN_ON_ERROR(handle->set_int_enable(handle, pin_num_mask, enable), TAG, "Set interrupt enable failed");
+    portENTER_CRITICAL(&runtime->lock);
+    if (enable) {
+        runtime->int_disabled_mask &= ~pin_num_mask;
+    } else {
+        runtime->int_disabled_mask |= pin_num_mask;
+    }
+    portEXIT_CRITICAL(&runtime->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_get_int_status(esp_io_expander_handle_t handle, uint32_t *status_mask)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(status_mask, ESP_ERR_INVALID_ARG, TAG, "Invalid status");
+    ESP_RETURN_ON_FALSE(handle->read_int_status, ESP_ERR_NOT_SUPPORTED, TAG, "Interrupt status not supported");
+
+    uint32_t status_reg;
+    ESP_RETURN_ON_ERROR(handle->read_int_status(handle, &status_reg), TAG, "Read interrupt status reg failed");
+    *status_mask = status_reg & VALID_PIN_MASK(handle);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_enable_int(esp_io_expander_handle_t handle, int int_gpio_num)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(GPIO_IS_VALID_GPIO(int_gpio_num), ESP_ERR_INVALID_ARG, TAG, "Invalid INT GPIO");
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+    ESP_RETURN_ON_FALSE(runtime->int_gpio_num < 0, ESP_ERR_INVALID_STATE, TAG, "INT already enabled");
+
+    const gpio_config_t int_gpio_config = {
+        .pin_bit_mask = BIT64(int_gpio_num),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .intr_type = GPIO_INTR_NEGEDGE,
+    };
+    ESP_RETURN_ON_ERROR(gpio_config(&int_gpio_config), TAG, "Config INT GPIO failed");
+    esp_err_t ret = gpio_install_isr_service(0);
+    /* The service may be installed by others */
+    ESP_RETURN_ON_FALSE((ret == ESP_OK) || (ret == ESP_ERR_INVALID_STATE), ret, TAG, "Install GPIO ISR service failed");
+    ESP_RETURN_ON_ERROR(gpio_isr_handler_add(int_gpio_num, int_isr_handler, runtime), TAG, "Add INT handler failed");
+    runtime->int_gpio_num = int_gpio_num;
+
+    /* Read the input register to release the interrupt pin which may be asserted before */
+    uint32_t input_reg;
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_INPUT, &input_reg), TAG, "Read input reg failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_disable_int(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+    if (!runtime || (runtime->int_gpio_num < 0)) {
+        return ESP_OK;
+    }
+
+    ESP_RETURN_ON_ERROR(gpio_isr_handler_remove(runtime->int_gpio_num), TAG, "Remove INT handler failed");
+    gpio_reset_pin(runtime->int_gpio_num);
+    runtime->int_gpio_num = -1;
+    /* Wake up the waiting tasks, so they can go back to polling */
+    notify_waiters(runtime);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_set_poll_interval(esp_io_expander_handle_t handle, uint32_t interval_ms)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(interval_ms > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid interval");
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+    runtime->poll_interval_ms = interval_ms;
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_wait_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level,
+                                     uint32_t timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(pin_num_mask, ESP_ERR_INVALID_ARG, TAG, "Invalid pin num mask");
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+
+    /* Link the waiter before the first read, so any interrupt after it won't be missed */
+    waiter_t waiter = {0};
+    waiter.sem = xSemaphoreCreateBinaryStatic(&waiter.sem_buf);
+    portENTER_CRITICAL(&runtime->lock);
+    waiter.next = runtime->waiters;
+    runtime->waiters = &waiter;
+    portEXIT_CRITICAL(&runtime->lock);
+
+    uint32_t expected = level ? pin_num_mask : 0;
+    TickType_t timeout_ticks = (timeout_ms == ESP_IO_EXPANDER_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    TickType_t start_tick = xTaskGetTickCount();
+    esp_err_t ret = ESP_OK;
+    while (1) {
+        uint32_t level_mask = 0;
+        ESP_GOTO_ON_ERROR(esp_io_expander_get_level(handle, pin_num_mask, &level_mask), end, TAG, "Get level failed");
+        if (level_mask == expected) {
+            break;
+        }
+
+        TickType_t wait_ticks = portMAX_DELAY;
+        if (timeout_ticks != portMAX_DELAY) {
+            TickType_t elapsed_ticks = xTaskGetTickCount() - start_tick;
+            if (elapsed_ticks >= timeout_ticks) {
+                ret = ESP_ERR_TIMEOUT;
+                break;
+            }
+            wait_ticks = timeout_ticks - elapsed_ticks;
+        }
+        if (runtime->int_gpio_num >= 0) {
+            xSemaphoreTake(waiter.sem, wait_ticks);
+        } else {
+            TickType_t poll_ticks = pdMS_TO_TICKS(runtime->poll_interval_ms);
+            poll_ticks = (poll_ticks > 0) ? poll_ticks : 1;
+            vTaskDelay((wait_ticks < poll_ticks) ? wait_ticks : poll_ticks);
+        }
+    }
+
+end:
+    portENTER_CRITICAL(&runtime->lock);
+    for (waiter_t **node = &runtime->waiters; *node; node = &(*node)->next) {
+        if (*node == &waiter) {
+            *node = waiter.next;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&runtime->lock);
+    vSemaphoreDelete(waiter.sem);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_subscribe(esp_io_expander_handle_t handle, const esp_io_expander_subscribe_config_t *config,
+                                    int *subscriber_id)
+{
+    ESP_RETURN_ON_FALSE(handle && config && subscriber_id, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(config->pin_num_mask, ESP_ERR_INVALID_ARG, TAG, "Invalid pin num mask");
+    ESP_RETURN_ON_FALSE(config->edge & IO_EXPANDER_EDGE_ANY, ESP_ERR_INVALID_ARG, TAG, "Invalid edge");
+    ESP_RETURN_ON_FALSE(config->callback || config->notify_task, ESP_ERR_INVALID_ARG, TAG, "No delivery method");
+    if (config->pin_num_mask & ~VALID_PIN_MASK(handle)) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTakeRecursive(runtime->sub_mutex, portMAX_DELAY);
+    if (!runtime->lut) {
+        uint8_t lane_num = (VALID_IO_COUNT(handle) + LUT_LANE_BITS - 1) / LUT_LANE_BITS;
+        runtime->lut = calloc(lane_num, sizeof(runtime->lut[0]));
+        ESP_GOTO_ON_FALSE(runtime->lut, ESP_ERR_NO_MEM, end, TAG, "Alloc lookup table failed");
+        runtime->lut_lane_num = lane_num;
+    }
+    ESP_GOTO_ON_FALSE(runtime->subscriber_used_mask != UINT32_MAX, ESP_ERR_NO_MEM, end, TAG, "No free subscriber");
+
+    int id = __builtin_ctz(~runtime->subscriber_used_mask);
+    runtime->subscribers[id].config = *config;
+    runtime->subscriber_used_mask |= BIT(id);
+    rebuild_lut(runtime);
+    *subscriber_id = id;
+
+end:
+    xSemaphoreGiveRecursive(runtime->sub_mutex);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_unsubscribe(esp_io_expander_handle_t handle, int subscriber_id)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE((subscriber_id >= 0) && (subscriber_id < ESP_IO_EXPANDER_SUBSCRIBER_NUM_MAX),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid subscriber id");
+
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_INVALID_STATE, TAG, "No subscriber");
+
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTakeRecursive(runtime->sub_mutex, portMAX_DELAY);
+    ESP_GOTO_ON_FALSE(runtime->subscriber_used_mask & BIT(subscriber_id), ESP_ERR_INVALID_STATE, end, TAG,
+                      "Subscriber not found");
+    runtime->subscriber_used_mask &= ~BIT(subscriber_id);
+    rebuild_lut(runtime);
+
+end:
+    xSemaphoreGiveRecursive(runtime->sub_mutex);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_check_changes(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+
+    /* The reaction time of the rules starts from the interrupt if any, otherwise from the read */
+    int64_t observed_us = esp_timer_get_time();
+    bool by_int = false;
+    uint32_t int_disabled_mask = 0;
+    portENTER_CRITICAL(&runtime->lock);
+    if (runtime->int_timestamp_us) {
+        observed_us = runtime->int_timestamp_us;
+        runtime->int_timestamp_us = 0;
+        by_int = true;
+    }
+    int_disabled_mask = runtime->int_disabled_mask;
+    portEXIT_CRITICAL(&runtime->lock);
+
+    uint32_t level_mask = 0;
+    /* The changes of the IOs without interrupt aren't flagged, so all IOs are read if any of them is tracked */
+    if (by_int && runtime->last_level_valid && handle->read_int_status && handle->read_input_reg_masked &&
+            !(int_disabled_mask & VALID_PIN_MASK(handle))) {
+        /* Only read the inputs flagged by the interrupt status, the others keep their last levels */
+        uint32_t status_mask = 0;
+        ESP_RETURN_ON_ERROR(esp_io_expander_get_int_status(handle, &status_mask), TAG, "Get interrupt status failed");
+        level_mask = runtime->last_level_mask;
+        if (status_mask) {
+            /* Reading a port clears the status of all its IOs, so all of them are updated */
+            uint32_t read_mask = 0;
+            uint8_t io_count = VALID_IO_COUNT(handle);
+            for (int i = 0; i < io_count; i += INPUT_PORT_IO_COUNT) {
+                uint32_t port_mask = (uint32_t)((BIT64(INPUT_PORT_IO_COUNT) - 1) << i);
+                if (status_mask & port_mask) {
+                    read_mask |= port_mask;
+                }
+            }
+            read_mask &= VALID_PIN_MASK(handle);
+            uint32_t read_level_mask = 0;
+            ESP_RETURN_ON_ERROR(
+                esp_io_expander_get_level(handle, read_mask, &read_level_mask), TAG, "Get level failed"
+            );
+            level_mask = (level_mask & ~read_mask) | read_level_mask;
+        }
+    } else {
+        ESP_RETURN_ON_ERROR(
+            esp_io_expander_get_level(handle, VALID_PIN_MASK(handle), &level_mask), TAG, "Get level failed"
+        );
+    }
+
+    xSemaphoreTakeRecursive(runtime->sub_mutex, portMAX_DELAY);
+    /* Write the outputs of the rules first, the subscribers can wait */
+    if (runtime->rule_used_mask && (!runtime->last_level_valid || (level_mask != runtime->last_level_mask))) {
+        if (apply_rules(handle, level_mask, observed_us) != ESP_OK) {
+            ESP_LOGE(TAG, "Apply rules failed");
+        }
+    }
+    if (runtime->last_level_valid && (level_mask != runtime->last_level_mask)) {
+        dispatch_changes(handle, runtime->last_level_mask, level_mask);
+    }
+    runtime->last_level_mask = level_mask;
+    runtime->last_level_valid = true;
+    xSemaphoreGiveRecursive(runtime->sub_mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_add_rule(esp_io_expander_handle_t handle, const esp_io_expander_rule_t *rule, int *rule_id)
+{
+    ESP_RETURN_ON_FALSE(handle && rule && rule_id, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(rule->output_pin_num_mask, ESP_ERR_INVALID_ARG, TAG, "Invalid output pin num mask");
+    if ((rule->input_pin_num_mask | rule->output_pin_num_mask) & ~VALID_PIN_MASK(handle)) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    uint32_t dir_reg;
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), TAG, "Read direction reg failed");
+    /* Get 1 if output, then check all output pins at once */
+    if (handle->config.flags.dir_out_bit_zero) {
+        dir_reg ^= 0xffffffff;
+    }
+    ESP_RETURN_ON_FALSE(
+        (rule->output_pin_num_mask & ~dir_reg) == 0, ESP_ERR_INVALID_STATE, TAG,
+        "Pin mask(0x%" PRIx32 ") can't be forced in input mode", rule->output_pin_num_mask & ~dir_reg
+    );
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTakeRecursive(runtime->sub_mutex, portMAX_DELAY);
+    ESP_GOTO_ON_FALSE(
+        runtime->rule_used_mask != (uint32_t)(BIT64(ESP_IO_EXPANDER_RULE_NUM_MAX) - 1), ESP_ERR_NO_MEM, end, TAG,
+        "No free rule"
+    );
+
+    int id = __builtin_ctz(~runtime->rule_used_mask);
+    runtime->rules[id] = *rule;
+    runtime->rule_used_mask |= BIT(id);
+    if (runtime->last_level_valid) {
+        ret = apply_rules(handle, runtime->last_level_mask, -1);
+        if (ret != ESP_OK) {
+            runtime->rule_used_mask &= ~BIT(id);
+            ESP_LOGE(TAG, "Apply rules failed");
+            goto end;
+        }
+    }
+    *rule_id = id;
+
+end:
+    xSemaphoreGiveRecursive(runtime->sub_mutex);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_remove_rule(esp_io_expander_handle_t handle, int rule_id)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE((rule_id >= 0) && (rule_id < ESP_IO_EXPANDER_RULE_NUM_MAX), ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid rule id");
+
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_INVALID_STATE, TAG, "No rule");
+
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTakeRecursive(runtime->sub_mutex, portMAX_DELAY);
+    ESP_GOTO_ON_FALSE(runtime->rule_used_mask & BIT(rule_id), ESP_ERR_INVALID_STATE, end, TAG, "Rule not found");
+    runtime->rule_used_mask &= ~BIT(rule_id);
+    /* Release the IOs forced only by this rule */
+    if (runtime->last_level_valid) {
+        ESP_GOTO_ON_ERROR(apply_rules(handle, runtime->last_level_mask, -1), end, TAG, "Apply rules failed");
+    }
+
+end:
+    xSemaphoreGiveRecursive(runtime->sub_mutex);
+
+    return ret;
+}
+
+esp_err_t esp_io_expander_get_rule_stats(esp_io_expander_handle_t handle, esp_io_expander_rule_stats_t *stats,
+        bool reset)
+{
+    ESP_RETURN_ON_FALSE(handle && stats, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+    if (!runtime) {
+        memset(stats, 0, sizeof(esp_io_expander_rule_stats_t));
+        return ESP_OK;
+    }
+
+    xSemaphoreTakeRecursive(runtime->sub_mutex, portMAX_DELAY);
+    *stats = runtime->rule_stats;
+    if (stats->write_count > 0) {
+        stats->reaction_time_avg_us = runtime->reaction_time_total_us / stats->write_count;
+    }
+    if (reset) {
+        memset(&runtime->rule_stats, 0, sizeof(runtime->rule_stats));
+        runtime->reaction_time_total_us = 0;
+    }
+    xSemaphoreGiveRecursive(runtime->sub_mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_start_monitor(esp_io_expander_handle_t handle, const esp_io_expander_monitor_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_runtime_t *runtime = get_runtime(handle);
+    ESP_RETURN_ON_FALSE(runtime, ESP_ERR_NO_MEM, TAG, "Create runtime failed");
+    ESP_RETURN_ON_FALSE(!runtime->monitor_task, ESP_ERR_INVALID_STATE, TAG, "Monitor already started");
+
+    const esp_io_expander_monitor_config_t default_config = ESP_IO_EXPANDER_MONITOR_CONFIG_DEFAULT();
+    if (!config) {
+        config = &default_config;
+    }
+
+    TaskHandle_t task = NULL;
+    runtime->monitor_running = true;
+    BaseType_t res = xTaskCreatePinnedToCore(monitor_task, "expander_monitor", config->task_stack_size, handle,
+                     config->task_priority, &task,
+                     (config->task_core_id < 0) ? tskNO_AFFINITY : config->task_core_id);
+    if (res != pdPASS) {
+        runtime->monitor_running = false;
+        ESP_LOGE(TAG, "Create monitor task failed");
+        return ESP_ERR_NO_MEM;
+    }
+    portENTER_CRITICAL(&runtime->lock);
+    runtime->monitor_task = task;
+    portEXIT_CRITICAL(&runtime->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_stop_monitor(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+    if (!runtime || !runtime->monitor_running) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(xTaskGetCurrentTaskHandle() != runtime->monitor_task, ESP_ERR_INVALID_STATE, TAG,
+                        "Can't stop in the monitor task");
+
+    runtime->monitor_running = false;
+    notify_waiters(runtime);
+    /* The task clears its handle right before deleting itself */
+    for (int i = 0; runtime->monitor_task && (i < MONITOR_STOP_WAIT_MS); i++) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    ESP_RETURN_ON_FALSE(!runtime->monitor_task, ESP_ERR_TIMEOUT, TAG, "Wait for monitor task exit timeout");
+
+    return ESP_OK;
+}
+
 esp_err_t esp_io_expander_print_state(esp_io_expander_handle_t handle)
 {
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
@@ -162,7 +1039,14 @@ esp_err_t esp_io_expander_reset(esp_io_expander_handle_t handle)
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
     ESP_RETURN_ON_FALSE(handle->reset, ESP_ERR_NOT_SUPPORTED, TAG, "reset isn't implemented");
 
-    return handle->reset(handle);
+    ESP_RETURN_ON_ERROR(handle->reset(handle), TAG, "Reset failed");
+    if (handle->runtime) {
+        portENTER_CRITICAL(&handle->runtime->lock);
+        handle->runtime->int_disabled_mask = 0;
+        portEXIT_CRITICAL(&handle->runtime->lock);
+    }
+
+    return ESP_OK;
 }
 
 esp_err_t esp_io_expander_del(esp_io_expander_handle_t handle)
@@ -170,6 +1054,18 @@ esp_err_t esp_io_expander_del(esp_io_expander_handle_t handle)
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
     ESP_RETURN_ON_FALSE(handle->del, ESP_ERR_NOT_SUPPORTED, TAG, "del isn't implemented");
 
+    if (handle->runtime) {
+        esp_io_expander_runtime_t *runtime = handle->runtime;
+        portENTER_CRITICAL(&runtime->lock);
+        bool has_waiters = (runtime->waiters != NULL);
+        portEXIT_CRITICAL(&runtime->lock);
+        /* The waiters live on the stacks of the waiting tasks and are unlinked from the runtime data by themselves */
+        ESP_RETURN_ON_FALSE(!has_waiters, ESP_ERR_INVALID_STATE, TAG, "Some tasks are still waiting for levels");
+        ESP_RETURN_ON_ERROR(esp_io_expander_stop_monitor(handle), TAG, "Stop monitor failed");
+        ESP_RETURN_ON_ERROR(esp_io_expander_disable_int(handle), TAG, "Disable INT failed");
+        free_runtime(handle);
+    }
+
     return handle->del(handle);
 }
 
@@ -227,3 +1123,267 @@ static esp_err_t read_reg(esp_io_expander_handle_t handle, reg_type_t reg, uint3
 
     return ESP_OK;
 }
+
+/**
+ * @brief Get the runtime data of the device, create it if not exist
+ *
+ * @param handle: IO Expander handle
+ * @return
+ *      - Runtime data if success, otherwise NULL
+ */
+static esp_io_expander_runtime_t *get_runtime(esp_io_expander_handle_t handle)
+{
+    if (handle->runtime) {
+        return handle->runtime;
+    }
+
+    esp_io_expander_runtime_t *runtime = (esp_io_expander_runtime_t *)calloc(1, sizeof(esp_io_expander_runtime_t));
+    if (!runtime) {
+        return NULL;
+    }
+    runtime->sub_mutex = xSemaphoreCreateRecursiveMutex();
+    if (!runtime->sub_mutex) {
+        free(runtime);
+        return NULL;
+    }
+    portMUX_INITIALIZE(&runtime->lock);
+    runtime->int_gpio_num = -1;
+    runtime->poll_interval_ms = ESP_IO_EXPANDER_POLL_INTERVAL_MS;
+    handle->runtime = runtime;
+
+    return runtime;
+}
+
+/**
+ * @brief Release the runtime data of the device
+ *
+ * @param handle: IO Expander handle
+ */
+static void free_runtime(esp_io_expander_handle_t handle)
+{
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+
+    vSemaphoreDelete(runtime->sub_mutex);
+    free(runtime->lut);
+    free(runtime);
+    handle->runtime = NULL;
+}
+
+/**
+ * @brief Wake up all tasks waiting for input changes, including the monitor task
+ *
+ * @param runtime: Runtime data of the device
+ */
+static void notify_waiters(esp_io_expander_runtime_t *runtime)
+{
+    /* The list is also accessed in ISR, so use the ISR version API inside the critical section */
+    portENTER_CRITICAL(&runtime->lock);
+    for (waiter_t *waiter = runtime->waiters; waiter; waiter = waiter->next) {
+        xSemaphoreGiveFromISR(waiter->sem, NULL);
+    }
+    if (runtime->monitor_task) {
+        vTaskNotifyGiveFromISR(runtime->monitor_task, NULL);
+    }
+    portEXIT_CRITICAL(&runtime->lock);
+}
+
+static void IRAM_ATTR int_isr_handler(void *arg)
+{
+    esp_io_expander_runtime_t *runtime = (esp_io_expander_runtime_t *)arg;
+    BaseType_t need_yield = pdFALSE;
+
+    portENTER_CRITICAL_ISR(&runtime->lock);
+    if (!runtime->int_timestamp_us) {
+        runtime->int_timestamp_us = esp_timer_get_time();
+    }
+    for (waiter_t *waiter = runtime->waiters; waiter; waiter = waiter->next) {
+        xSemaphoreGiveFromISR(waiter->sem, &need_yield);
+    }
+    if (runtime->monitor_task) {
+        vTaskNotifyGiveFromISR(runtime->monitor_task, &need_yield);
+    }
+    portEXIT_CRITICAL_ISR(&runtime->lock);
+
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Rebuild the lookup table from the subscribers, should be called with `sub_mutex` taken
+ *
+ * @param runtime: Runtime data of the device
+ */
+static void rebuild_lut(esp_io_expander_runtime_t *runtime)
+{
+    uint32_t pin_subscribers[IO_COUNT_MAX] = {0};
+    for (uint32_t used = runtime->subscriber_used_mask; used; used &= used - 1) {
+        int id = __builtin_ctz(used);
+        for (uint32_t pins = runtime->subscribers[id].config.pin_num_mask; pins; pins &= pins - 1) {
+            pin_subscribers[__builtin_ctz(pins)] |= BIT(id);
+        }
+    }
+
+    /* Each entry is the entry without its lowest bit plus the subscribers of that bit */
+    for (int lane = 0; lane < runtime->lut_lane_num; lane++) {
+        uint32_t *table = runtime->lut[lane];
+        table[0] = 0;
+        for (int bits = 1; bits < LUT_LANE_SIZE; bits++) {
+            table[bits] = table[bits & (bits - 1)] | pin_subscribers[lane * LUT_LANE_BITS + __builtin_ctz(bits)];
+        }
+    }
+}
+
+/**
+ * @brief Deliver the input changes to the matched subscribers, should be called with `sub_mutex` taken
+ *
+ * @param handle: IO Expander handle
+ * @param old_level_mask: Levels of all IOs before the change
+ * @param new_level_mask: Levels of all IOs after the change
+ */
+static void dispatch_changes(esp_io_expander_handle_t handle, uint32_t old_level_mask, uint32_t new_level_mask)
+{
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+    uint32_t changed = old_level_mask ^ new_level_mask;
+    uint32_t rising = changed & new_level_mask;
+    uint32_t falling = changed & ~new_level_mask;
+
+    /* Only visit the subscribers watching any of the changed IOs */
+    uint32_t candidates = 0;
+    for (int lane = 0; lane < runtime->lut_lane_num; lane++) {
+        uint8_t lane_bits = (changed >> (lane * LUT_LANE_BITS)) & (LUT_LANE_SIZE - 1);
+        if (lane_bits) {
+            candidates |= runtime->lut[lane][lane_bits];
+        }
+    }
+    candidates &= runtime->subscriber_used_mask;
+
+    esp_io_expander_event_t event = {
+        .level_mask = new_level_mask,
+        .timestamp_us = esp_timer_get_time(),
+    };
+    for (; candidates; candidates &= candidates - 1) {
+        int id = __builtin_ctz(candidates);
+        /* The subscriber may be removed by a previous callback */
+        if (!(runtime->subscriber_used_mask & BIT(id))) {
+            continue;
+        }
+        const esp_io_expander_subscribe_config_t *config = &runtime->subscribers[id].config;
+        uint32_t matched = 0;
+        if (config->edge & IO_EXPANDER_EDGE_RISING) {
+            matched |= rising;
+        }
+        if (config->edge & IO_EXPANDER_EDGE_FALLING) {
+            matched |= falling;
+        }
+        matched &= config->pin_num_mask;
+        if (!matched) {
+            continue;
+        }
+
+        if (config->callback) {
+            event.pin_num_mask = matched;
+            config->callback(handle, &event, config->user_ctx);
+        } else {
+            xTaskNotify(config->notify_task, config->notify_bits ? config->notify_bits : matched, eSetBits);
+        }
+    }
+}
+
+static void monitor_task(void *arg)
+{
+    esp_io_expander_handle_t handle = (esp_io_expander_handle_t)arg;
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+
+    ESP_LOGD(TAG, "Monitor task start");
+
+    while (runtime->monitor_running) {
+        if (esp_io_expander_check_changes(handle) != ESP_OK) {
+            ESP_LOGE(TAG, "Check changes failed");
+        }
+        TickType_t wait_ticks = portMAX_DELAY;
+        if (runtime->int_gpio_num < 0) {
+            wait_ticks = pdMS_TO_TICKS(runtime->poll_interval_ms);
+            wait_ticks = (wait_ticks > 0) ? wait_ticks : 1;
+        }
+        ulTaskNotifyTake(pdTRUE, wait_ticks);
+    }
+
+    ESP_LOGD(TAG, "Monitor task exit");
+
+    /* Clear the handle inside the critical section, so the ISR won't notify a deleted task */
+    portENTER_CRITICAL(&runtime->lock);
+    runtime->monitor_task = NULL;
+    portEXIT_CRITICAL(&runtime->lock);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Evaluate the rules with the input levels and write the forced outputs at once if they change, should be
+ *        called with `sub_mutex` taken
+ *
+ * @param handle: IO Expander handle
+ * @param level_mask: Levels of all IOs
+ * @param observed_us: Time when the levels are observed, -1 means not an input change and not counted in the stats
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+static esp_err_t apply_rules(esp_io_expander_handle_t handle, uint32_t level_mask, int64_t observed_us)
+{
+    esp_io_expander_runtime_t *runtime = handle->runtime;
+
+    /* Rules with larger IDs override the smaller ones */
+    uint32_t forced_mask = 0;
+    uint32_t forced_level_mask = 0;
+    for (uint32_t used = runtime->rule_used_mask; used; used &= used - 1) {
+        const esp_io_expander_rule_t *rule = &runtime->rules[__builtin_ctz(used)];
+        if ((level_mask ^ rule->input_level_mask) & rule->input_pin_num_mask) {
+            continue;
+        }
+        forced_mask |= rule->output_pin_num_mask;
+        forced_level_mask = (forced_level_mask & ~rule->output_pin_num_mask) |
+                            (rule->output_level_mask & rule->output_pin_num_mask);
+    }
+    /* The IOs in open-drain mode can't be forced through the output register */
+    forced_mask &= ~runtime->open_drain_mask;
+    forced_level_mask &= forced_mask;
+    if (observed_us >= 0) {
+        runtime->rule_stats.eval_count++;
+    }
+    if ((forced_mask == runtime->forced_mask) && (forced_level_mask == runtime->forced_level_mask)) {
+        return ESP_OK;
+    }
+
+    uint32_t output_reg;
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), TAG, "Read output reg failed");
+    /* Get 1 if output high level */
+    uint32_t invert_mask = handle->config.flags.output_high_bit_zero ? 0xffffffff : 0;
+    uint32_t levels = output_reg ^ invert_mask;
+    /* Remember the levels of the newly forced IOs and restore the released ones */
+    uint32_t newly_forced_mask = forced_mask & ~runtime->forced_mask;
+    uint32_t released_mask = runtime->forced_mask & ~forced_mask;
+    runtime->user_level_mask = (runtime->user_level_mask & ~newly_forced_mask) | (levels & newly_forced_mask);
+    levels = (levels & ~released_mask) | (runtime->user_level_mask & released_mask);
+    levels = (levels & ~forced_mask) | forced_level_mask;
+
+    if ((levels ^ invert_mask) != output_reg) {
+        esp_err_t ret = write_reg(handle, REG_OUTPUT, levels ^ invert_mask);
+        if (ret != ESP_OK) {
+            runtime->rule_stats.error_count++;
+            ESP_LOGE(TAG, "Write output reg failed");
+            return ret;
+        }
+        if (observed_us >= 0) {
+            uint32_t reaction_time_us = (uint32_t)(esp_timer_get_time() - observed_us);
+            runtime->rule_stats.write_count++;
+            runtime->reaction_time_total_us += reaction_time_us;
+            if (reaction_time_us > runtime->rule_stats.reaction_time_max_us) {
+                runtime->rule_stats.reaction_time_max_us = reaction_time_us;
+            }
+        }
+    }
+    runtime->forced_mask = forced_mask;
+    runtime->forced_level_mask = forced_level_mask;
+
+    return ESP_OK;
+}
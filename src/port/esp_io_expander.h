@@ -12,9 +12,12 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,12 +25,22 @@ extern "C" {
 
 #define IO_COUNT_MAX        (sizeof(uint32_t) * 8)
 
+#define ESP_IO_EXPANDER_WAIT_FOREVER        (UINT32_MAX)
+#define ESP_IO_EXPANDER_POLL_INTERVAL_MS    (10)
+#define ESP_IO_EXPANDER_SUBSCRIBER_NUM_MAX  (32)
+#define ESP_IO_EXPANDER_RULE_NUM_MAX        (16)
+
 /**
  * @brief IO Expander Device Type
  */
 typedef struct esp_io_expander_s esp_io_expander_t;
 typedef esp_io_expander_t *esp_io_expander_handle_t;
 
+/**
+ * @brief Runtime data used by the generic functions, such as the interrupt and the waiting tasks
+ */
+typedef struct esp_io_expander_runtime_s esp_io_expander_runtime_t;
+
 /**
  * @brief IO Expander Pin Num
  */
@@ -74,6 +87,113 @@ typedef enum {
     IO_EXPANDER_OUTPUT,         /*!< Output direction */
 } esp_io_expander_dir_t;
 
+/**
+ * @brief IO Expander pull resistor
+ */
+typedef enum {
+    IO_EXPANDER_PULL_NONE,      /*!< No pull resistor */
+    IO_EXPANDER_PULL_UP,        /*!< Pull-up resistor */
+    IO_EXPANDER_PULL_DOWN,      /*!< Pull-down resistor */
+} esp_io_expander_pull_t;
+
+/**
+ * @brief IO Expander output drive strength
+ */
+typedef enum {
+    IO_EXPANDER_DRIVE_0_25X,    /*!< 0.25x of the full drive strength */
+    IO_EXPANDER_DRIVE_0_5X,     /*!< 0.5x of the full drive strength */
+    IO_EXPANDER_DRIVE_0_75X,    /*!< 0.75x of the full drive strength */
+    IO_EXPANDER_DRIVE_1X,       /*!< Full drive strength */
+} esp_io_expander_drive_t;
+
+/**
+ * @brief IO Expander input edge
+ */
+typedef enum {
+    IO_EXPANDER_EDGE_RISING  = (1 << 0),    /*!< Low to high */
+    IO_EXPANDER_EDGE_FALLING = (1 << 1),    /*!< High to low */
+    IO_EXPANDER_EDGE_ANY     = (IO_EXPANDER_EDGE_RISING | IO_EXPANDER_EDGE_FALLING),    /*!< Both edges */
+} esp_io_expander_edge_t;
+
+/**
+ * @brief IO Expander input change event
+ */
+typedef struct {
+    uint32_t pin_num_mask;      /*!< Subscribed IOs which changed with the subscribed edge */
+    uint32_t level_mask;        /*!< Levels of all IOs after the change. For each bit, 0 - Low level, 1 - High level */
+    int64_t timestamp_us;       /*!< Time when the change is observed, from `esp_timer_get_time()` */
+} esp_io_expander_event_t;
+
+/**
+ * @brief Callback of input change events
+ *
+ * @param handle: IO Expander handle
+ * @param event: Input change event
+ * @param user_ctx: User data passed by `esp_io_expander_subscribe_config_t`
+ */
+typedef void (*esp_io_expander_event_cb_t)(esp_io_expander_handle_t handle, const esp_io_expander_event_t *event,
+        void *user_ctx);
+
+/**
+ * @brief IO Expander subscription configuration
+ *
+ * @note Either `callback` or `notify_task` should be set. If both are set, only `callback` is used.
+ */
+typedef struct {
+    uint32_t pin_num_mask;              /*!< Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t` */
+    esp_io_expander_edge_t edge;        /*!< Edges to subscribe */
+    esp_io_expander_event_cb_t callback;/*!< Called in the task which observes the change, should return quickly */
+    void *user_ctx;                     /*!< User data passed to `callback` */
+    TaskHandle_t notify_task;           /*!< Task notified by `xTaskNotify(eSetBits)` */
+    uint32_t notify_bits;               /*!< Bits set in the notification value of `notify_task`, 0 means setting the
+                                             matched pin num mask */
+} esp_io_expander_subscribe_config_t;
+
+/**
+ * @brief IO Expander monitor task configuration
+ */
+typedef struct {
+    int task_priority;                  /*!< Priority of the monitor task */
+    uint32_t task_stack_size;           /*!< Stack size of the monitor task */
+    int task_core_id;                   /*!< Core of the monitor task, -1 means no affinity */
+} esp_io_expander_monitor_config_t;
+
+#define ESP_IO_EXPANDER_MONITOR_CONFIG_DEFAULT() \
+    {                                           \
+        .task_priority = 5,                     \
+        .task_stack_size = 4096,                \
+        .task_core_id = -1,                     \
+    }
+
+/**
+ * @brief IO Expander input-to-output rule
+ *
+ * @note The rule is active while the levels of all its input IOs match `input_level_mask`, and then its output IOs are
+ *       forced to `output_level_mask`
+ */
+typedef struct {
+    uint32_t input_pin_num_mask;        /*!< Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`,
+                                             0 means always active */
+    uint32_t input_level_mask;          /*!< Levels of the input IOs to activate the rule. For each bit, 0 - Low level,
+                                             1 - High level */
+    uint32_t output_pin_num_mask;       /*!< Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`,
+                                             these IOs should be in output mode */
+    uint32_t output_level_mask;         /*!< Levels forced to the output IOs. For each bit, 0 - Low level, 1 - High
+                                             level */
+} esp_io_expander_rule_t;
+
+/**
+ * @brief IO Expander rule statistics
+ */
+typedef struct {
+    uint32_t eval_count;                /*!< Number of evaluations, one per observed input change */
+    uint32_t write_count;               /*!< Number of output writes caused by the rules */
+    uint32_t error_count;               /*!< Number of failed output writes */
+    uint32_t reaction_time_avg_us;      /*!< Average time from the input change to the output write done. The change
+                                             time is the interrupt if enabled, otherwise the start of the input read */
+    uint32_t reaction_time_max_us;      /*!< Maximum time from the input change to the output write done */
+} esp_io_expander_rule_stats_t;
+
 /**
  * @brief IO Expander Configuration Type
  */
@@ -83,8 +203,9 @@ typedef struct {
         uint8_t dir_out_bit_zero : 1;       /*!< If the direction of IO is output, the corresponding bit of the direction register is 0 */
         uint8_t input_high_bit_zero : 1;    /*!< If the input level of IO is high, the corresponding bit of the input register is 0 */
         uint8_t output_high_bit_zero : 1;   /*!< If the output level of IO is high, the corresponding bit of the output register is 0 */
+        uint8_t dir_shared : 1;             /*!< If the direction is set for all IOs together instead of each IO (e.g. CH422G) */
+        uint8_t output_quasi_bidirectional : 1; /*!< If the high output level is a weak pull-up which can be pulled low by others (e.g. HT8574) */
     } flags;
-    /* Don't support with interrupt mode yet, will be added soon */
 } esp_io_expander_config_t;
 
 struct esp_io_expander_s {
@@ -183,10 +304,132 @@ struct esp_io_expander_s {
      */
     esp_err_t (*del)(esp_io_expander_handle_t handle);
 
+    /**
+     * @brief Write value to output register and then read value from input register in a single transaction (optional)
+     *
+     * @note This function is used to drive some IOs and sample the inputs right after, such as scanning a key matrix.
+     *       If it isn't implemented, the two registers will be accessed one after another.
+     * @note If there are multiple registers in the device, their values should be spliced together in order to form the
+     *       `output_value` and `input_value`.
+     *
+     * @param handle: IO Expander handle
+     * @param output_value: Output register's value
+     * @param input_value: Input register's value
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*write_output_read_input)(esp_io_expander_handle_t handle, uint32_t output_value, uint32_t *input_value);
+
+    /**
+     * @brief Write a sequence of values to output register in a single transaction (optional)
+     *
+     * @note This function is used to output waveforms at the bus speed. If it isn't implemented, each value will be
+     *       written by `write_output_reg()` one after another.
+     * @note After this function, the output register should be recorded as the last value.
+     *
+     * @param handle: IO Expander handle
+     * @param values: Output register's values
+     * @param count: Number of values
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*write_output_stream)(esp_io_expander_handle_t handle, const uint32_t *values, size_t count);
+
+    /**
+     * @brief Read value from the input registers covering some pins (optional)
+     *
+     * @note This function is used to read a part of the pins with less data, such as a single port of a multi-port
+     *       device. If it isn't implemented, `read_input_reg()` will be used.
+     * @note The bits of the pins not in `pin_num_mask` are undefined.
+     *
+     * @param handle: IO Expander handle
+     * @param pin_num_mask: Pins to read (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param value: Register's value
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*read_input_reg_masked)(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value);
+
+    /**
+     * @brief Set the pull resistor of some IOs (optional)
+     *
+     * @param handle: IO Expander handle
+     * @param pin_num_mask: Pins to set (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param pull: Pull resistor
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*set_pull)(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_pull_t pull);
+
+    /**
+     * @brief Set the output drive strength of some IOs (optional)
+     *
+     * @param handle: IO Expander handle
+     * @param pin_num_mask: Pins to set (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param drive: Drive strength
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*set_drive)(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_drive_t drive);
+
+    /**
+     * @brief Enable or disable the input latch of some IOs (optional)
+     *
+     * @note A latched input keeps its changed level until the input register is read, so short pulses between two
+     *       reads aren't lost.
+     *
+     * @param handle: IO Expander handle
+     * @param pin_num_mask: Pins to set (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param enable: Enable or disable
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*set_input_latch)(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+
+    /**
+     * @brief Enable or disable the interrupt of some IOs (optional)
+     *
+     * @param handle: IO Expander handle
+     * @param pin_num_mask: Pins to set (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param enable: Enable or disable
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*set_int_enable)(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+
+    /**
+     * @brief Read the interrupt status register (optional)
+     *
+     * @note Every bit represents an IO whose input changed since the input register was read last time. The status is
+     *       cleared by reading the input register.
+     * @note If it is implemented together with `read_input_reg_masked()`, an interrupt is serviced by reading the status
+     *       and then only the input registers (8-bit ports) of the changed IOs. The interrupts of all IOs should be
+     *       enabled by `reset()`.
+     *
+     * @param handle: IO Expander handle
+     * @param value: Register's value
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*read_int_status)(esp_io_expander_handle_t handle, uint32_t *value);
+
     /**
      * @brief Configuration structure
      */
     esp_io_expander_config_t config;
+
+    /**
+     * @brief Runtime data, created and released by the generic functions. Drivers should leave it untouched.
+     */
+    esp_io_expander_runtime_t *runtime;
 };
 
 /**
@@ -201,10 +444,122 @@ struct esp_io_expander_s {
  */
 esp_err_t esp_io_expander_set_dir(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_dir_t direction);
 
+/**
+ * @brief Set a set of target IOs to emulated open-drain mode, released (high impedance) at first
+ *
+ * @note For push-pull devices, the output register is latched to low once, and then each level change of the IOs only
+ *       writes the direction register: low level (assert) is output mode and high level (release) is input mode.
+ *       For quasi-bidirectional devices (e.g. HT8574), the levels are written to the output register directly.
+ * @note After this function, `esp_io_expander_set_level()` sets the level of these IOs through
+ *       `esp_io_expander_set_open_drain_level()`, and `esp_io_expander_get_level()` reads the level of the line.
+ *       `esp_io_expander_set_dir()` quits the open-drain mode of the IOs.
+ * @note The IOs in open-drain mode are left unchanged by `esp_io_expander_set_output()`,
+ *       `esp_io_expander_exchange_level()`, `esp_io_expander_write_output_stream()` and the rules, since their output
+ *       register must keep low level. The IOs forced by the rules can't be set to open-drain mode.
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NOT_SUPPORTED: The direction of the device can't be set for each IO (e.g. CH422G)
+ *      - ESP_ERR_INVALID_STATE: Some target IOs are forced by the rules
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_set_open_drain(esp_io_expander_handle_t handle, uint32_t pin_num_mask);
+
+/**
+ * @brief Assert (low level) or release (high level) a set of target IOs in open-drain mode, by a single register write
+ *
+ * @note All target IOs must be in open-drain mode first (see `esp_io_expander_set_open_drain()`), otherwise this
+ *       function will return the error `ESP_ERR_INVALID_STATE`
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param level: 0 - Low level (assert), 1 - High level (release)
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_set_open_drain_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level);
+
+/**
+ * @brief Set the pull resistor of a set of target IOs
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param pull: Pull resistor
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NOT_SUPPORTED: The device doesn't support it
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_set_pull(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_pull_t pull);
+
+/**
+ * @brief Set the output drive strength of a set of target IOs
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param drive: Drive strength
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NOT_SUPPORTED: The device doesn't support it
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_set_drive(esp_io_expander_handle_t handle, uint32_t pin_num_mask,
+                                    esp_io_expander_drive_t drive);
+
+/**
+ * @brief Enable or disable the input latch of a set of target IOs, so short pulses between two reads aren't lost
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param enable: Enable or disable
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NOT_SUPPORTED: The device doesn't support it
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_set_input_latch(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+
+/**
+ * @brief Enable or disable the interrupt of a set of target IOs
+ *
+ * @note The devices without interrupt mask always generate interrupts for all input IOs.
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param enable: Enable or disable
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NOT_SUPPORTED: The device doesn't support it
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_set_int_enable(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+
+/**
+ * @brief Get the IOs whose input changed since the input register was read last time, from the interrupt status
+ *
+ * @param handle: IO Exapnder handle
+ * @param status_mask: Bitwise OR of the changed pin num
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NOT_SUPPORTED: The device doesn't support it
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_get_int_status(esp_io_expander_handle_t handle, uint32_t *status_mask);
+
 /**
  * @brief Set the output level of a set of target IOs
  *
- * @note All target IOs must be in output mode first, otherwise this function will return the error `ESP_ERR_INVALID_STATE`
+ * @note All target IOs must be in output mode first, otherwise this function will return the error `ESP_ERR_INVALID_STATE`.
+ *       The IOs in open-drain mode are asserted or released instead.
  *
  * @param handle: IO Exapnder handle
  * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
@@ -215,6 +570,23 @@ esp_err_t esp_io_expander_set_dir(esp_io_expander_handle_t handle, uint32_t pin_
  */
 esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level);
 
+/**
+ * @brief Latch the output levels of a set of target IOs and then set them to output mode
+ *
+ * @note Unlike `esp_io_expander_set_level()`, the target IOs don't need to be in output mode first. The levels are
+ *       written to the output register before the direction register, so the IOs start driving at the given levels
+ *       without any glitch (e.g. the CS line of a bus).
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param level_mask: Bitwise OR of levels. For each bit, 0 - Low level, 1 - High level. Bits not in `pin_num_mask` are
+ *                    ignored
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_set_output(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t level_mask);
+
 /**
  * @brief Get the input level of a set of target IOs
  *
@@ -229,6 +601,224 @@ esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pi
  */
 esp_err_t esp_io_expander_get_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *level_mask);
 
+/**
+ * @brief Set the output level of each target IO separately and then get the input level of a set of target IOs
+ *
+ * @note All target output IOs must be in output mode first, otherwise this function will return the error
+ *       `ESP_ERR_INVALID_STATE`
+ * @note If the device supports it, the output and input registers are accessed in a single transaction, which makes
+ *       this function suitable for scanning a key matrix
+ *
+ * @param handle: IO Exapnder handle
+ * @param set_pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t` to set the level
+ * @param set_level_mask: Bitwise OR of levels to set. For each bit, 0 - Low level, 1 - High level
+ * @param get_pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t` to get the level
+ * @param get_level_mask: Bitwise OR of levels got. For each bit, 0 - Low level, 1 - High level
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_exchange_level(esp_io_expander_handle_t handle, uint32_t set_pin_num_mask,
+        uint32_t set_level_mask, uint32_t get_pin_num_mask, uint32_t *get_level_mask);
+
+/**
+ * @brief Set the output level of a set of target IOs to a sequence of values, one after another
+ *
+ * @note All target IOs must be in output mode first, otherwise this function will return the error
+ *       `ESP_ERR_INVALID_STATE`
+ * @note If the device supports it, the whole sequence is written in a single transaction, so the outputs change at the
+ *       bus speed (e.g. HT8574 latches every byte written). Otherwise, each value takes a transaction.
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param level_masks: Sequence of levels. For each bit, 0 - Low level, 1 - High level. Bits not in `pin_num_mask` are
+ *                     ignored and these IOs keep their current level
+ * @param count: Number of values in the sequence
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_write_output_stream(esp_io_expander_handle_t handle, uint32_t pin_num_mask,
+        const uint32_t *level_masks, size_t count);
+
+/**
+ * @brief Enable the interrupt pin of the device
+ *
+ * @note The interrupt pin is expected to be active low and open-drain (e.g. TCA95xx, HT8574), so the internal pull-up
+ *       of the GPIO is enabled. It is asserted when any input changes and released when the input register is read.
+ * @note Once enabled, functions waiting for input changes (e.g. `esp_io_expander_wait_level()`) block on the interrupt
+ *       instead of polling the device.
+ * @note The GPIO ISR service will be installed if it isn't installed yet
+ *
+ * @param handle: IO Exapnder handle
+ * @param int_gpio_num: GPIO number connected to the interrupt pin of the device
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_enable_int(esp_io_expander_handle_t handle, int int_gpio_num);
+
+/**
+ * @brief Disable the interrupt pin of the device
+ *
+ * @note Functions waiting for input changes will go back to polling the device
+ *
+ * @param handle: IO Exapnder handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_disable_int(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Set the interval of polling the device when the interrupt pin isn't enabled
+ *
+ * @param handle: IO Exapnder handle
+ * @param interval_ms: Polling interval, default is `ESP_IO_EXPANDER_POLL_INTERVAL_MS`
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_set_poll_interval(esp_io_expander_handle_t handle, uint32_t interval_ms);
+
+/**
+ * @brief Block the calling task until the input level of all target IOs becomes the expected one
+ *
+ * @note The device is read once when called and then only when the interrupt pin is asserted (if enabled by
+ *       `esp_io_expander_enable_int()`) or every polling interval (set by `esp_io_expander_set_poll_interval()`)
+ * @note This function can't be called from ISR
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param level: 0 - Low level, 1 - High level
+ * @param timeout_ms: Maximum time to wait, `ESP_IO_EXPANDER_WAIT_FOREVER` means no timeout
+ *
+ * @return
+ *      - ESP_OK: All target IOs are in the expected level
+ *      - ESP_ERR_TIMEOUT: Timeout
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_wait_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level,
+                                     uint32_t timeout_ms);
+
+/**
+ * @brief Subscribe the input changes of a set of target IOs
+ *
+ * @note Changes are observed by `esp_io_expander_check_changes()`, which is called by the monitor task (see
+ *       `esp_io_expander_start_monitor()`) or by users. Only the subscribers matching the changed IOs are visited,
+ *       through a table indexed by each byte of the changed-bit mask.
+ *
+ * @param handle: IO Exapnder handle
+ * @param config: Subscription configuration
+ * @param subscriber_id: ID of the subscriber, used to unsubscribe
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NO_MEM: No free subscriber slot (max `ESP_IO_EXPANDER_SUBSCRIBER_NUM_MAX`) or memory
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_subscribe(esp_io_expander_handle_t handle, const esp_io_expander_subscribe_config_t *config,
+                                    int *subscriber_id);
+
+/**
+ * @brief Unsubscribe the input changes
+ *
+ * @note This function can be called in the event callback
+ *
+ * @param handle: IO Exapnder handle
+ * @param subscriber_id: ID got from `esp_io_expander_subscribe()`
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_unsubscribe(esp_io_expander_handle_t handle, int subscriber_id);
+
+/**
+ * @brief Read the input levels once and dispatch the changes since the last read to the subscribers
+ *
+ * @note The first call only records the levels
+ * @note If called after an interrupt and the device reports its interrupt status (e.g. PCAL95xx with 16 IOs), only the
+ *       ports of the flagged IOs are read and the others keep their last levels. All IOs are read if the interrupt of
+ *       any IO is disabled by `esp_io_expander_set_int_enable()`, since its changes aren't flagged.
+ *
+ * @param handle: IO Exapnder handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_check_changes(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Create a task to check the input changes when the interrupt pin is asserted (if enabled by
+ *        `esp_io_expander_enable_int()`) or every polling interval (set by `esp_io_expander_set_poll_interval()`)
+ *
+ * @param handle: IO Exapnder handle
+ * @param config: Monitor task configuration, NULL means `ESP_IO_EXPANDER_MONITOR_CONFIG_DEFAULT()`
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_start_monitor(esp_io_expander_handle_t handle, const esp_io_expander_monitor_config_t *config);
+
+/**
+ * @brief Stop and delete the monitor task
+ *
+ * @note This function can't be called in the event callback
+ *
+ * @param handle: IO Exapnder handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_stop_monitor(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Add an input-to-output rule, which is evaluated when the input changes are observed
+ *
+ * @note The rules are evaluated by `esp_io_expander_check_changes()` (e.g. in the monitor task) right after the input
+ *       read, and the resulting output levels are written at once, before the subscribers are called. So the reaction
+ *       doesn't go through any application task.
+ * @note If several active rules force the same output IO, the rule with the largest ID wins.
+ * @note While an output IO is forced, `esp_io_expander_set_level()` records the level for it and applies it once the
+ *       IO is released, other functions setting the output levels leave it unchanged.
+ * @note The rule is evaluated at once with the last observed input levels, if any
+ *
+ * @param handle: IO Exapnder handle
+ * @param rule: Rule
+ * @param rule_id: ID of the rule, used to remove it
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Some output IOs are in input mode
+ *      - ESP_ERR_NO_MEM: No free rule slot (max `ESP_IO_EXPANDER_RULE_NUM_MAX`) or memory
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_add_rule(esp_io_expander_handle_t handle, const esp_io_expander_rule_t *rule, int *rule_id);
+
+/**
+ * @brief Remove an input-to-output rule, the output IOs forced only by it are restored to the levels set by users
+ *
+ * @param handle: IO Exapnder handle
+ * @param rule_id: ID got from `esp_io_expander_add_rule()`
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_remove_rule(esp_io_expander_handle_t handle, int rule_id);
+
+/**
+ * @brief Get the statistics of the input-to-output rules
+ *
+ * @param handle: IO Exapnder handle
+ * @param stats: Statistics
+ * @param reset: Reset the statistics after getting them
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_get_rule_stats(esp_io_expander_handle_t handle, esp_io_expander_rule_stats_t *stats,
+        bool reset);
+
 /**
  * @brief Print the current status of each IO of the device, including direction, input level and output level
  *
@@ -254,10 +844,14 @@ esp_err_t esp_io_expander_reset(esp_io_expander_handle_t handle);
 /**
  * @brief Delete device
  *
+ * @note All tasks blocked in `esp_io_expander_wait_level()` should return before this function
+ *
  * @param handle: IO Expander handle
  *
  * @return
- *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Some tasks are still waiting for levels of the device
+ *      - Others: Fail
  */
 esp_err_t esp_io_expander_del(esp_io_expander_handle_t handle);
 
@@ -0,0 +1,349 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "driver/i2c.h"
+#include "esp_bit_defs.h"
+#include "esp_check.h"
+#include "esp_log.h"
+
+#include "esp_io_expander.h"
+#include "esp_io_expander_aw9523b.h"
+
+#include "esp_expander_utils.h"
+
+/* Timeout of each I2C communication */
+#define I2C_TIMEOUT_MS          (10)
+
+#define IO_COUNT                (16)
+
+/* Register address, the one of P1 follows the one of P0 */
+#define INPUT_REG_ADDR          (0x00)
+#define OUTPUT_REG_ADDR         (0x02)
+#define DIRECTION_REG_ADDR      (0x04)
+#define INT_MASK_REG_ADDR       (0x06)
+#define CONTROL_REG_ADDR        (0x11)
+#define LED_MODE_REG_ADDR       (0x12)
+#define DIM_REG_ADDR            (0x20)
+#define SW_RESET_REG_ADDR       (0x7F)
+
+/* Bits of the control register */
+#define CONTROL_BIT_P0_PUSH_PULL (1 << 4)
+
+/* Register value after reset */
+#define DIR_REG_DEFAULT_VAL     (0xffff)
+#define OUT_REG_DEFAULT_VAL     (0xffff)
+#define LED_MODE_REG_DEFAULT_VAL (0xffff)   /* 1 means GPIO mode */
+
+/* Pins of each 8-bit port */
+#define PORT0_MASK              (0x00ff)
+#define PORT1_MASK              (0xff00)
+
+/**
+ * @brief Device Structure Type
+ */
+typedef struct {
+    esp_io_expander_t base;
+    i2c_port_t i2c_num;
+    uint32_t i2c_address;
+    struct {
+        uint16_t direction;
+        uint16_t output;
+        uint16_t int_mask;
+        uint16_t led_mode;
+        uint8_t dim[IO_COUNT];  /* Indexed by register, not by pin */
+    } regs;
+} esp_io_expander_aw9523b_t;
+
+static const char *TAG = "aw9523b";
+
+static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value);
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t set_int_enable(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+static esp_err_t reset(esp_io_expander_t *handle);
+static esp_err_t del(esp_io_expander_t *handle);
+static esp_err_t write_reg_pair(esp_io_expander_aw9523b_t *aw, uint8_t reg_addr, uint16_t *shadow, uint16_t value);
+static esp_err_t write_dim_regs(esp_io_expander_aw9523b_t *aw, const uint8_t *dim);
+
+/**
+ * @brief Get the index of the dimming register of a pin, the registers are ordered as P1_0-P1_3, P0_0-P0_7, P1_4-P1_7
+ */
+static inline int get_dim_index(int pin)
+{
+    if (pin < 8) {
+        return pin + 4;
+    }
+    return (pin < 12) ? (pin - 8) : pin;
+}
+
+esp_err_t esp_io_expander_new_i2c_aw9523b(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle)
+{
+    ESP_LOGI(TAG, "version: %d.%d.%d", ESP_IO_EXPANDER_AW9523B_VER_MAJOR, ESP_IO_EXPANDER_AW9523B_VER_MINOR,
+             ESP_IO_EXPANDER_AW9523B_VER_PATCH);
+    ESP_RETURN_ON_FALSE(i2c_num < I2C_NUM_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid i2c num");
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)calloc(1, sizeof(esp_io_expander_aw9523b_t));
+    ESP_RETURN_ON_FALSE(aw, ESP_ERR_NO_MEM, TAG, "Malloc failed");
+
+    aw->base.config.io_count = IO_COUNT;
+    aw->base.config.flags.dir_out_bit_zero = 1;
+    aw->i2c_num = i2c_num;
+    aw->i2c_address = i2c_address;
+    aw->base.read_input_reg = read_input_reg;
+    aw->base.read_input_reg_masked = read_input_reg_masked;
+    aw->base.write_output_reg = write_output_reg;
+    aw->base.read_output_reg = read_output_reg;
+    aw->base.write_direction_reg = write_direction_reg;
+    aw->base.read_direction_reg = read_direction_reg;
+    aw->base.set_int_enable = set_int_enable;
+    aw->base.del = del;
+    aw->base.reset = reset;
+
+    esp_err_t ret = ESP_OK;
+    /* Reset configuration and register status */
+    ESP_GOTO_ON_ERROR(reset(&aw->base), err, TAG, "Reset failed");
+
+    *handle = &aw->base;
+    return ESP_OK;
+err:
+    free(aw);
+    return ret;
+}
+
+esp_err_t esp_io_expander_aw9523b_set_led_mode(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    /* Set 0 for LED mode */
+    uint16_t led_mode = enable ? (aw->regs.led_mode & ~pin_num_mask) : (aw->regs.led_mode | pin_num_mask);
+    ESP_RETURN_ON_ERROR(write_reg_pair(aw, LED_MODE_REG_ADDR, &aw->regs.led_mode, led_mode), TAG, "Write LED mode reg failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_aw9523b_set_led_current(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    uint8_t dim[IO_COUNT];
+    memcpy(dim, aw->regs.dim, sizeof(dim));
+    for (int pin = 0; pin < IO_COUNT; pin++) {
+        if (pin_num_mask & BIT(pin)) {
+            dim[get_dim_index(pin)] = level;
+        }
+    }
+    ESP_RETURN_ON_ERROR(write_dim_regs(aw, dim), TAG, "Write dim regs failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_aw9523b_write_led_currents(esp_io_expander_handle_t handle, uint8_t start_pin,
+        const uint8_t *levels, size_t num)
+{
+    ESP_RETURN_ON_FALSE(handle && levels, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(start_pin + num <= IO_COUNT, ESP_ERR_INVALID_ARG, TAG, "Pins out of range");
+
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    uint8_t dim[IO_COUNT];
+    memcpy(dim, aw->regs.dim, sizeof(dim));
+    for (size_t i = 0; i < num; i++) {
+        dim[get_dim_index(start_pin + i)] = levels[i];
+    }
+    ESP_RETURN_ON_ERROR(write_dim_regs(aw, dim), TAG, "Write dim regs failed");
+
+    return ESP_OK;
+}
+
+static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    uint8_t temp[2] = {0, 0};
+    // *INDENT-OFF*
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_read_device(aw->i2c_num, aw->i2c_address, (uint8_t[]){INPUT_REG_ADDR}, 1, temp, sizeof(temp), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Read input reg failed");
+    // *INDENT-ON*
+    *value = (((uint32_t)temp[1]) << 8) | (temp[0]);
+    return ESP_OK;
+}
+
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    if ((pin_num_mask & PORT0_MASK) && (pin_num_mask & PORT1_MASK)) {
+        return read_input_reg(handle, value);
+    }
+
+    /* Only read the port of the pins */
+    bool is_port1 = (pin_num_mask & PORT1_MASK);
+    uint8_t reg_addr = INPUT_REG_ADDR + (is_port1 ? 1 : 0);
+    uint8_t temp = 0;
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_read_device(aw->i2c_num, aw->i2c_address, &reg_addr, 1, &temp, 1, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Read input reg failed");
+    *value = is_port1 ? (((uint32_t)temp) << 8) : temp;
+    return ESP_OK;
+}
+
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    ESP_RETURN_ON_ERROR(write_reg_pair(aw, OUTPUT_REG_ADDR, &aw->regs.output, value & 0xffff), TAG, "Write output reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    *value = aw->regs.output;
+    return ESP_OK;
+}
+
+static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    ESP_RETURN_ON_ERROR(
+        write_reg_pair(aw, DIRECTION_REG_ADDR, &aw->regs.direction, value & 0xffff), TAG, "Write direction reg failed"
+    );
+    return ESP_OK;
+}
+
+static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    *value = aw->regs.direction;
+    return ESP_OK;
+}
+
+static esp_err_t set_int_enable(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    /* Set 1 to disable the interrupt */
+    uint16_t int_mask = enable ? (aw->regs.int_mask & ~pin_num_mask) : (aw->regs.int_mask | pin_num_mask);
+    ESP_RETURN_ON_ERROR(write_reg_pair(aw, INT_MASK_REG_ADDR, &aw->regs.int_mask, int_mask), TAG, "Write interrupt mask reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t reset(esp_io_expander_t *handle)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    /**
+     * After the software reset, all pins are GPIO outputs with the interrupts enabled and the LED currents are 0.
+     * P0 is open-drain by default, set it to push-pull as other chips. Then the output is written before the
+     * direction, so all writes are sent in a single transaction chained by repeated starts.
+     */
+    uint8_t data[][3] = {
+        {SW_RESET_REG_ADDR, 0x00},
+        {CONTROL_REG_ADDR, CONTROL_BIT_P0_PUSH_PULL},
+        {OUTPUT_REG_ADDR, OUT_REG_DEFAULT_VAL & 0xff, OUT_REG_DEFAULT_VAL >> 8},
+        {DIRECTION_REG_ADDR, DIR_REG_DEFAULT_VAL & 0xff, DIR_REG_DEFAULT_VAL >> 8},
+        {LED_MODE_REG_ADDR, LED_MODE_REG_DEFAULT_VAL & 0xff, LED_MODE_REG_DEFAULT_VAL >> 8},
+    };
+    const size_t size[] = {2, 2, 3, 3, 3};
+    const int msg_num = sizeof(size) / sizeof(size[0]);
+    uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(5)] = {0};
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Create cmd link failed");
+    for (int i = 0; i < msg_num; i++) {
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, (aw->i2c_address << 1) | I2C_MASTER_WRITE, true);
+        i2c_master_write(cmd, data[i], size[i], true);
+    }
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_master_cmd_begin(aw->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    ESP_RETURN_ON_ERROR(ret, TAG, "Reset regs failed");
+    aw->regs.output = OUT_REG_DEFAULT_VAL;
+    aw->regs.direction = DIR_REG_DEFAULT_VAL;
+    aw->regs.led_mode = LED_MODE_REG_DEFAULT_VAL;
+    aw->regs.int_mask = 0;
+    memset(aw->regs.dim, 0, sizeof(aw->regs.dim));
+    return ESP_OK;
+}
+
+static esp_err_t del(esp_io_expander_t *handle)
+{
+    esp_io_expander_aw9523b_t *aw = (esp_io_expander_aw9523b_t *)__containerof(handle, esp_io_expander_aw9523b_t, base);
+
+    free(aw);
+    return ESP_OK;
+}
+
+/**
+ * @brief Write a register pair, only the ports whose value changed are sent
+ */
+static esp_err_t write_reg_pair(esp_io_expander_aw9523b_t *aw, uint8_t reg_addr, uint16_t *shadow, uint16_t value)
+{
+    uint16_t changed = *shadow ^ value;
+    uint8_t data[3] = {reg_addr, value & 0xff, value >> 8};
+    size_t size = sizeof(data);
+
+    if (changed == 0) {
+        return ESP_OK;
+    } else if (!(changed & PORT1_MASK)) {
+        size = 2;
+    } else if (!(changed & PORT0_MASK)) {
+        data[0] = reg_addr + 1;
+        data[1] = value >> 8;
+        size = 2;
+    }
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_to_device(aw->i2c_num, aw->i2c_address, data, size, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Write reg(0x%02x) failed", data[0]);
+    *shadow = value;
+    return ESP_OK;
+}
+
+/**
+ * @brief Write the span of the changed dimming registers in a single burst, the register address increases after
+ *        each byte
+ */
+static esp_err_t write_dim_regs(esp_io_expander_aw9523b_t *aw, const uint8_t *dim)
+{
+    int first = -1;
+    int last = -1;
+    for (int i = 0; i < IO_COUNT; i++) {
+        if (dim[i] != aw->regs.dim[i]) {
+            if (first < 0) {
+                first = i;
+            }
+            last = i;
+        }
+    }
+    if (first < 0) {
+        return ESP_OK;
+    }
+
+    uint8_t data[1 + IO_COUNT] = {DIM_REG_ADDR + first};
+    size_t size = 1 + last - first + 1;
+    memcpy(&data[1], &dim[first], last - first + 1);
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_to_device(aw->i2c_num, aw->i2c_address, data, size, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Write dim reg(0x%02x) failed", data[0]);
+    memcpy(&aw->regs.dim[first], &dim[first], last - first + 1);
+    return ESP_OK;
+}
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP IO expander: AW9523B
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "driver/i2c.h"
+#include "esp_err.h"
+
+#include "esp_io_expander.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_IO_EXPANDER_AW9523B_VER_MAJOR    (1)
+#define ESP_IO_EXPANDER_AW9523B_VER_MINOR    (0)
+#define ESP_IO_EXPANDER_AW9523B_VER_PATCH    (0)
+
+/* Number of the LED current levels, 0 means off */
+#define ESP_IO_EXPANDER_AW9523B_LED_LEVEL_NUM   (256)
+
+/**
+ * @brief Create a new AW9523B IO expander driver
+ *
+ * @note The I2C communication should be initialized before use this function
+ * @note The chip is reset by software, then P0 is set to push-pull like P1, and all pins are set to GPIO input mode
+ *
+ * @param i2c_num: I2C port num
+ * @param i2c_address: I2C address of chip (\see esp_io_expander_aw9523b_address)
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_new_i2c_aw9523b(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle);
+
+/**
+ * @brief Switch some pins between the constant-current LED mode and the GPIO mode
+ *
+ * @note In LED mode, the pin sinks the current set by `esp_io_expander_aw9523b_set_led_current()`, so the LED is
+ *       dimmed by the chip without any bus traffic
+ *
+ * @param handle: IO expander handle
+ * @param pin_num_mask: Pins to switch (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+ * @param enable: true for LED mode, false for GPIO mode
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_aw9523b_set_led_mode(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+
+/**
+ * @brief Set the same LED current level of some pins
+ *
+ * @note All changed dimming registers are written in a single I2C burst
+ *
+ * @param handle: IO expander handle
+ * @param pin_num_mask: Pins to set (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+ * @param level: Current level, 0 (off) to 255 (maximum)
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_aw9523b_set_led_current(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level);
+
+/**
+ * @brief Set the LED current levels of consecutive pins
+ *
+ * @note All changed dimming registers are written in a single I2C burst
+ *
+ * @param handle: IO expander handle
+ * @param start_pin: First pin (0-15)
+ * @param levels: Current levels of the pins from `start_pin`, 0 (off) to 255 (maximum)
+ * @param num: Number of the levels
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_aw9523b_write_led_currents(esp_io_expander_handle_t handle, uint8_t start_pin,
+        const uint8_t *levels, size_t num);
+
+/**
+ * @brief I2C address of the AW9523B
+ *
+ * The 8-bit address format is as follows:
+ *
+ *                (Slave Address)
+ *     ┌─────────────────┷─────────────────┐
+ *  ┌─────┐─────┐─────┐─────┐─────┐─────┐─────┐─────┐
+ *  |  1  |  0  |  1  |  1  |  0  | AD1 | AD0 | R/W |
+ *  └─────┘─────┘─────┘─────┘─────┘─────┘─────┘─────┘
+ *     └───────────┯───────────┘     └──┯──┘
+ *              (Fixed)        (Hardware Selectable)
+ *
+ * And the 7-bit slave address is the most important data for users.
+ * For example, if a chip's AD0,AD1 are connected to GND, it's 7-bit slave address is 1011000b(0x58).
+ * Then users can use `ESP_IO_EXPANDER_I2C_AW9523B_ADDRESS_00` to init it.
+ */
+enum esp_io_expander_aw9523b_address {
+    ESP_IO_EXPANDER_I2C_AW9523B_ADDRESS_00 = 0b1011000,
+    ESP_IO_EXPANDER_I2C_AW9523B_ADDRESS_01 = 0b1011001,
+    ESP_IO_EXPANDER_I2C_AW9523B_ADDRESS_10 = 0b1011010,
+    ESP_IO_EXPANDER_I2C_AW9523B_ADDRESS_11 = 0b1011011,
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -12,6 +12,11 @@
 #include "esp_bit_defs.h"
 #include "esp_check.h"
 #include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 
 #include "esp_io_expander.h"
 #include "esp_io_expander_ch422g.h"
@@ -23,11 +28,15 @@
 
 #define IO_COUNT                (12)
 
+/* Time for IO0-7 to settle after switching to input mode */
+#define INPUT_SETTLE_US         (2000)
+
 /* Register address */
 #define CH422G_REG_WR_SET       (0x48 >> 1)
 #define CH422G_REG_WR_OC        (0x46 >> 1)
 #define CH422G_REG_WR_IO        (0x70 >> 1)
 #define CH422G_REG_RD_IO        (0x4D >> 1)
+#define CH422G_REG_WR_DIG0      (0x70 >> 1)     // Same as WR-IO, used in display scan mode
 
 /* Default register value when reset */
 // *INDENT-OFF*
@@ -44,6 +53,7 @@
 #define REG_DIR_DEFAULT_VAL     (0xFFFU)
 
 #define REG_WR_SET_BIT_IO_OE    (1U << 0)
+#define REG_WR_SET_BIT_A_SCAN   (1U << 1)
 #define REG_WR_SET_BIT_OD_EN    (1U << 2)
 #define REG_WR_SET_BIT_SLEEP    (1U << 3)
 
@@ -58,7 +68,27 @@ typedef struct {
         uint8_t wr_set;
         uint8_t wr_oc;
         uint8_t wr_io;
+        uint8_t wr_dig[ESP_IO_EXPANDER_CH422G_DISPLAY_DIGIT_NUM - 1];  /* DIG1-3, DIG0 shares WR-IO */
     } regs;
+    bool regs_synced;                   /* Whether the shadow registers match the device, false until reset */
+    int64_t input_ready_us;             /* Time when IO0-7 can be read after switching to input mode */
+    esp_io_expander_ch422g_ready_cb_t input_ready_cb;
+    void *input_ready_user_ctx;
+    esp_timer_handle_t input_ready_timer;
+    portMUX_TYPE input_ready_lock;      /* Keeps the callback and its context consistent for the timer callback */
+    struct {
+        SemaphoreHandle_t mutex;        /* Serializes the accesses with the sleep timer, created when first enabled */
+        esp_timer_handle_t timer;
+        uint32_t idle_us;               /* 0 means disabled */
+        int64_t last_access_us;
+        int64_t sleep_start_us;
+        bool is_sleeping;               /* Entered sleep by the policy, woken by the next access */
+        uint32_t sleep_count;
+        uint32_t wake_count;
+        uint64_t wake_latency_total_us;
+        uint32_t wake_latency_max_us;
+        uint64_t sleep_time_total_us;
+    } auto_sleep;
 } esp_io_expander_ch422g_t;
 
 static const char *TAG = "ch422g";
@@ -70,6 +100,19 @@ static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t v
 static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
 static esp_err_t reset(esp_io_expander_t *handle);
 static esp_err_t del(esp_io_expander_t *handle);
+static esp_err_t write_reg(esp_io_expander_ch422g_t *ch422g, uint8_t reg_addr, uint8_t *shadow, uint8_t value);
+static esp_err_t write_reg_force(esp_io_expander_ch422g_t *ch422g, uint8_t reg_addr, uint8_t *shadow, uint8_t value);
+static uint8_t *get_digit_shadow(esp_io_expander_ch422g_t *ch422g, uint8_t digit);
+static esp_err_t write_wr_set(esp_io_expander_ch422g_t *ch422g, uint8_t value);
+static void wait_input_ready(esp_io_expander_ch422g_t *ch422g);
+static void input_ready_timer_cb(void *arg);
+static esp_err_t wait_timer_callbacks(void);
+static void fence_timer_cb(void *arg);
+static void auto_sleep_lock(esp_io_expander_ch422g_t *ch422g);
+static void auto_sleep_unlock(esp_io_expander_ch422g_t *ch422g);
+static esp_err_t auto_sleep_wake(esp_io_expander_ch422g_t *ch422g);
+static void auto_sleep_record_wake(esp_io_expander_ch422g_t *ch422g, uint32_t latency_us);
+static void auto_sleep_timer_cb(void *arg);
 
 esp_err_t esp_io_expander_new_i2c_ch422g(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle)
 {
@@ -82,11 +125,13 @@ esp_err_t esp_io_expander_new_i2c_ch422g(i2c_port_t i2c_num, uint32_t i2c_addres
     ESP_RETURN_ON_FALSE(ch422g, ESP_ERR_NO_MEM, TAG, "Malloc failed");
 
     ch422g->base.config.io_count = IO_COUNT;
+    ch422g->base.config.flags.dir_shared = 1;
     ch422g->i2c_num = i2c_num;
     ch422g->i2c_address = i2c_address;
     ch422g->regs.wr_set = REG_WR_SET_DEFAULT_VAL;
     ch422g->regs.wr_oc = REG_WR_OC_DEFAULT_VAL;
     ch422g->regs.wr_io = REG_WR_IO_DEFAULT_VAL;
+    portMUX_INITIALIZE(&ch422g->input_ready_lock);
     ch422g->base.read_input_reg = read_input_reg;
     ch422g->base.write_output_reg = write_output_reg;
     ch422g->base.read_output_reg = read_output_reg;
@@ -112,12 +157,7 @@ esp_err_t esp_io_expander_ch422g_set_oc_open_drain(esp_io_expander_handle_t hand
     uint8_t data = (uint8_t)(ch422g->regs.wr_set | REG_WR_SET_BIT_OD_EN);
 
     // WR-SET
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(
-            ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)
-        ), TAG, "Write WR_SET reg failed"
-    );
-    ch422g->regs.wr_set = data;
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
 
     return ESP_OK;
 }
@@ -128,12 +168,7 @@ esp_err_t esp_io_expander_ch422g_set_oc_push_pull(esp_io_expander_handle_t handl
     uint8_t data = (uint8_t)(ch422g->regs.wr_set & ~REG_WR_SET_BIT_OD_EN);
 
     // WR-SET
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(
-            ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)
-        ), TAG, "Write WR_SET reg failed"
-    );
-    ch422g->regs.wr_set = data;
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
 
     return ESP_OK;
 }
@@ -144,14 +179,8 @@ esp_err_t esp_io_expander_ch422g_set_all_input(esp_io_expander_handle_t handle)
     uint8_t data = (uint8_t)(ch422g->regs.wr_set & ~REG_WR_SET_BIT_IO_OE);
 
     // WR-SET
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(
-            ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)
-        ), TAG, "Write WR_SET reg failed"
-    );
-    ch422g->regs.wr_set = data;
-    // Delay 1ms to wait for the IO expander to switch to input mode
-    vTaskDelay(pdMS_TO_TICKS(2));
+    // Don't wait for IO0-7 to settle here, the next input read will wait for the remaining time if it comes too early
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
 
     return ESP_OK;
 }
@@ -162,12 +191,7 @@ esp_err_t esp_io_expander_ch422g_set_all_output(esp_io_expander_handle_t handle)
     uint8_t data = (uint8_t)(ch422g->regs.wr_set | REG_WR_SET_BIT_IO_OE);
 
     // WR-SET
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(
-            ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)
-        ), TAG, "Write WR_SET reg failed"
-    );
-    ch422g->regs.wr_set = data;
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
 
     return ESP_OK;
 }
@@ -178,12 +202,7 @@ esp_err_t esp_io_expander_ch422g_enter_sleep(esp_io_expander_handle_t handle)
     uint8_t data = (uint8_t)(ch422g->regs.wr_set | REG_WR_SET_BIT_SLEEP);
 
     // WR-SET
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(
-            ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)
-        ), TAG, "Write WR_SET reg failed"
-    );
-    ch422g->regs.wr_set = data;
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
 
     return ESP_OK;
 }
@@ -194,12 +213,187 @@ esp_err_t esp_io_expander_ch422g_exit_sleep(esp_io_expander_handle_t handle)
     uint8_t data = (uint8_t)(ch422g->regs.wr_set & ~REG_WR_SET_BIT_SLEEP);
 
     // WR-SET
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(
-            ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)
-        ), TAG, "Write WR_SET reg failed"
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_ch422g_set_input_ready_callback(esp_io_expander_handle_t handle,
+        esp_io_expander_ch422g_ready_cb_t callback, void *user_ctx)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
+    if ((callback != NULL) && (ch422g->input_ready_timer == NULL)) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = input_ready_timer_cb,
+            .arg = ch422g,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "ch422g_input_ready",
+            .skip_unhandled_events = true,
+        };
+        ESP_RETURN_ON_ERROR(esp_timer_create(&timer_args, &ch422g->input_ready_timer), TAG, "Create timer failed");
+    }
+    if (ch422g->input_ready_timer != NULL) {
+        esp_timer_stop(ch422g->input_ready_timer);
+    }
+    portENTER_CRITICAL(&ch422g->input_ready_lock);
+    ch422g->input_ready_cb = callback;
+    ch422g->input_ready_user_ctx = user_ctx;
+    portEXIT_CRITICAL(&ch422g->input_ready_lock);
+    // The old callback may be dispatched already, so wait for it to return before its context is released
+    if (ch422g->input_ready_timer != NULL) {
+        ESP_RETURN_ON_ERROR(wait_timer_callbacks(), TAG, "Wait timer callbacks failed");
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_ch422g_is_input_ready(esp_io_expander_handle_t handle, bool *ready)
+{
+    ESP_RETURN_ON_FALSE(handle && ready, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
+    *ready = !(ch422g->regs.wr_set & REG_WR_SET_BIT_IO_OE) && (esp_timer_get_time() >= ch422g->input_ready_us);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_ch422g_set_auto_sleep(esp_io_expander_handle_t handle, uint32_t idle_ms)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
+    if ((idle_ms > 0) && (ch422g->auto_sleep.timer == NULL)) {
+        ch422g->auto_sleep.mutex = xSemaphoreCreateMutex();
+        ESP_RETURN_ON_FALSE(ch422g->auto_sleep.mutex, ESP_ERR_NO_MEM, TAG, "Create mutex failed");
+
+        const esp_timer_create_args_t timer_args = {
+            .callback = auto_sleep_timer_cb,
+            .arg = ch422g,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "ch422g_sleep",
+            .skip_unhandled_events = true,
+        };
+        esp_err_t ret = esp_timer_create(&timer_args, &ch422g->auto_sleep.timer);
+        if (ret != ESP_OK) {
+            vSemaphoreDelete(ch422g->auto_sleep.mutex);
+            ch422g->auto_sleep.mutex = NULL;
+            ESP_LOGE(TAG, "Create timer failed");
+            return ret;
+        }
+    }
+    if (ch422g->auto_sleep.timer == NULL) {
+        return ESP_OK;
+    }
+
+    auto_sleep_lock(ch422g);
+    esp_timer_stop(ch422g->auto_sleep.timer);
+    ch422g->auto_sleep.idle_us = idle_ms * 1000;
+    ch422g->auto_sleep.last_access_us = esp_timer_get_time();
+    esp_err_t ret = ESP_OK;
+    if (idle_ms > 0) {
+        ret = esp_timer_start_once(ch422g->auto_sleep.timer, ch422g->auto_sleep.idle_us);
+    } else if (ch422g->auto_sleep.is_sleeping) {
+        // Don't leave the chip sleeping without anyone to wake it
+        ret = auto_sleep_wake(ch422g);
+    }
+    auto_sleep_unlock(ch422g);
+    ESP_RETURN_ON_ERROR(ret, TAG, "Update auto sleep failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_ch422g_get_sleep_stats(esp_io_expander_handle_t handle,
+        esp_io_expander_ch422g_sleep_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(handle && stats, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
+    auto_sleep_lock(ch422g);
+    int64_t now_us = esp_timer_get_time();
+    uint64_t sleep_time_us = ch422g->auto_sleep.sleep_time_total_us;
+    if (ch422g->auto_sleep.is_sleeping) {
+        sleep_time_us += now_us - ch422g->auto_sleep.sleep_start_us;
+    }
+    stats->sleep_count = ch422g->auto_sleep.sleep_count;
+    stats->wake_count = ch422g->auto_sleep.wake_count;
+    stats->wake_latency_avg_us = (ch422g->auto_sleep.wake_count > 0) ?
+                                 (uint32_t)(ch422g->auto_sleep.wake_latency_total_us / ch422g->auto_sleep.wake_count) : 0;
+    stats->wake_latency_max_us = ch422g->auto_sleep.wake_latency_max_us;
+    stats->sleep_time_ms = (uint32_t)(sleep_time_us / 1000);
+    if (reset) {
+        ch422g->auto_sleep.sleep_count = 0;
+        ch422g->auto_sleep.wake_count = 0;
+        ch422g->auto_sleep.wake_latency_total_us = 0;
+        ch422g->auto_sleep.wake_latency_max_us = 0;
+        ch422g->auto_sleep.sleep_time_total_us = 0;
+        if (ch422g->auto_sleep.is_sleeping) {
+            ch422g->auto_sleep.sleep_start_us = now_us;
+        }
+    }
+    auto_sleep_unlock(ch422g);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_ch422g_enable_display_scan(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
+    uint8_t data = (uint8_t)(ch422g->regs.wr_set | REG_WR_SET_BIT_A_SCAN | REG_WR_SET_BIT_IO_OE);
+
+    // WR-SET
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
+    // Blank all digits, whose registers are unknown until now
+    for (uint8_t i = 0; i < ESP_IO_EXPANDER_CH422G_DISPLAY_DIGIT_NUM; i++) {
+        ESP_RETURN_ON_ERROR(
+            write_reg_force(ch422g, CH422G_REG_WR_DIG0 + i, get_digit_shadow(ch422g, i), 0), TAG,
+            "Write DIG%d reg failed", i
+        );
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_ch422g_disable_display_scan(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
+    uint8_t data = (uint8_t)(ch422g->regs.wr_set & ~REG_WR_SET_BIT_A_SCAN);
+
+    // WR-SET, IO0-7 keep the segments of DIG0 as their output levels
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
+
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_ch422g_write_display_digits(esp_io_expander_handle_t handle, uint8_t start_digit,
+        const uint8_t *segments, size_t digit_num)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(segments || (digit_num == 0), ESP_ERR_INVALID_ARG, TAG, "Invalid segments");
+    ESP_RETURN_ON_FALSE(
+        (start_digit < ESP_IO_EXPANDER_CH422G_DISPLAY_DIGIT_NUM) &&
+        (digit_num <= (size_t)(ESP_IO_EXPANDER_CH422G_DISPLAY_DIGIT_NUM - start_digit)), ESP_ERR_INVALID_ARG, TAG,
+        "Invalid digits"
+    );
+
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
+    ESP_RETURN_ON_FALSE(
+        ch422g->regs.wr_set & REG_WR_SET_BIT_A_SCAN, ESP_ERR_INVALID_STATE, TAG, "Display scan is not enabled"
     );
-    ch422g->regs.wr_set = data;
+
+    // The chip refreshes the digits by itself, so only the changed digits are sent
+    for (size_t i = 0; i < digit_num; i++) {
+        uint8_t digit = start_digit + i;
+        ESP_RETURN_ON_ERROR(
+            write_reg(ch422g, CH422G_REG_WR_DIG0 + digit, get_digit_shadow(ch422g, digit), segments[i]), TAG,
+            "Write DIG%d reg failed", digit
+        );
+    }
 
     return ESP_OK;
 }
@@ -209,39 +403,39 @@ static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value
     esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
     uint8_t temp = 0;
 
-    ESP_RETURN_ON_ERROR(
+    esp_err_t ret = ESP_OK;
+
+    auto_sleep_lock(ch422g);
+    ESP_GOTO_ON_ERROR(auto_sleep_wake(ch422g), end, TAG, "Wake failed");
+    wait_input_ready(ch422g);
+    ESP_GOTO_ON_ERROR(
         i2c_master_read_from_device(ch422g->i2c_num, CH422G_REG_RD_IO, &temp, 1, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-        TAG, "Read RD-IO reg failed"
+        end, TAG, "Read RD-IO reg failed"
     );
     *value = temp;
 
-    return ESP_OK;
+end:
+    auto_sleep_unlock(ch422g);
+    return ret;
 }
 
 static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value)
 {
     esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
 
+    ESP_RETURN_ON_FALSE(
+        !(ch422g->regs.wr_set & REG_WR_SET_BIT_A_SCAN), ESP_ERR_INVALID_STATE, TAG,
+        "IO0-7 and OC0-3 are driven by the display scan"
+    );
+
     uint8_t wr_oc_data = (value & 0xF00) >> 8;
     uint8_t wr_io_data = value & 0xFF;
 
+    // Only the command whose byte changed is sent, so a single pin change costs one 1-byte transaction
     // WR-OC
-    if (wr_oc_data) {
-        ESP_RETURN_ON_ERROR(
-            i2c_master_write_to_device(ch422g->i2c_num, CH422G_REG_WR_OC, &wr_oc_data, sizeof(wr_oc_data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-            TAG, "Write WR-OC reg failed"
-        );
-        ch422g->regs.wr_oc = wr_oc_data;
-    }
-
+    ESP_RETURN_ON_ERROR(write_reg(ch422g, CH422G_REG_WR_OC, &ch422g->regs.wr_oc, wr_oc_data), TAG, "Write WR-OC reg failed");
     // WR-IO
-    if (wr_io_data) {
-        ESP_RETURN_ON_ERROR(
-            i2c_master_write_to_device(ch422g->i2c_num, CH422G_REG_WR_IO, &wr_io_data, sizeof(wr_io_data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-            TAG, "Write WR-IO reg failed"
-        );
-        ch422g->regs.wr_io = wr_io_data;
-    }
+    ESP_RETURN_ON_ERROR(write_reg(ch422g, CH422G_REG_WR_IO, &ch422g->regs.wr_io, wr_io_data), TAG, "Write WR-IO reg failed");
 
     return ESP_OK;
 }
@@ -268,11 +462,7 @@ static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t v
     }
 
     // WR-SET
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-        TAG, "Write WR_SET reg failed"
-    );
-    ch422g->regs.wr_set = data;
+    ESP_RETURN_ON_ERROR(write_wr_set(ch422g, data), TAG, "Write WR_SET reg failed");
 
     return ESP_OK;
 }
@@ -291,8 +481,14 @@ static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *v
 
 static esp_err_t reset(esp_io_expander_t *handle)
 {
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
+
+    // The device state is unknown, so all registers are written whatever the shadow is
+    ch422g->regs_synced = false;
+    ch422g->regs.wr_set &= ~REG_WR_SET_BIT_A_SCAN;
     ESP_RETURN_ON_ERROR(write_direction_reg(handle, REG_DIR_DEFAULT_VAL), TAG, "Write direction reg (WR_SET) failed");
     ESP_RETURN_ON_ERROR(write_output_reg(handle, REG_OUT_DEFAULT_VAL), TAG, "Write output reg (WR_OC & WR_IO) failed");
+    ch422g->regs_synced = true;
 
     return ESP_OK;
 }
@@ -301,6 +497,258 @@ static esp_err_t del(esp_io_expander_t *handle)
 {
     esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)__containerof(handle, esp_io_expander_ch422g_t, base);
 
+    if (ch422g->auto_sleep.timer != NULL) {
+        // Disable the policy first, so a running callback doesn't rearm the timer
+        auto_sleep_lock(ch422g);
+        ch422g->auto_sleep.idle_us = 0;
+        auto_sleep_unlock(ch422g);
+        esp_timer_stop(ch422g->auto_sleep.timer);
+    }
+    if (ch422g->input_ready_timer != NULL) {
+        esp_timer_stop(ch422g->input_ready_timer);
+    }
+    if ((ch422g->auto_sleep.timer != NULL) || (ch422g->input_ready_timer != NULL)) {
+        // The callbacks may be dispatched already, so wait for them to return before the device is freed
+        ESP_RETURN_ON_ERROR(wait_timer_callbacks(), TAG, "Wait timer callbacks failed");
+    }
+    if (ch422g->auto_sleep.timer != NULL) {
+        esp_timer_delete(ch422g->auto_sleep.timer);
+        vSemaphoreDelete(ch422g->auto_sleep.mutex);
+    }
+    if (ch422g->input_ready_timer != NULL) {
+        esp_timer_delete(ch422g->input_ready_timer);
+    }
     free(ch422g);
     return ESP_OK;
 }
+
+/**
+ * @brief Write a 1-byte command register, skipped if the value equals the shadow which is in sync with the device
+ */
+static esp_err_t write_reg(esp_io_expander_ch422g_t *ch422g, uint8_t reg_addr, uint8_t *shadow, uint8_t value)
+{
+    if (ch422g->regs_synced && (*shadow == value)) {
+        return ESP_OK;
+    }
+
+    return write_reg_force(ch422g, reg_addr, shadow, value);
+}
+
+static esp_err_t write_reg_force(esp_io_expander_ch422g_t *ch422g, uint8_t reg_addr, uint8_t *shadow, uint8_t value)
+{
+    esp_err_t ret = ESP_OK;
+    bool wake_in_write = false;
+
+    auto_sleep_lock(ch422g);
+    if (ch422g->auto_sleep.is_sleeping && (reg_addr == CH422G_REG_WR_SET)) {
+        // The write itself wakes the chip, no extra transaction
+        value &= ~REG_WR_SET_BIT_SLEEP;
+        wake_in_write = true;
+    } else {
+        ESP_GOTO_ON_ERROR(auto_sleep_wake(ch422g), end, TAG, "Wake failed");
+    }
+    ESP_GOTO_ON_ERROR(
+        i2c_master_write_to_device(ch422g->i2c_num, reg_addr, &value, sizeof(value), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        end, TAG, "Write reg(0x%02x) failed", reg_addr
+    );
+    *shadow = value;
+    if (wake_in_write) {
+        auto_sleep_record_wake(ch422g, 0);
+    }
+
+end:
+    auto_sleep_unlock(ch422g);
+    return ret;
+}
+
+static uint8_t *get_digit_shadow(esp_io_expander_ch422g_t *ch422g, uint8_t digit)
+{
+    return (digit == 0) ? &ch422g->regs.wr_io : &ch422g->regs.wr_dig[digit - 1];
+}
+
+/**
+ * @brief Write WR_SET, and start the settling time of IO0-7 if they are switched to input mode
+ */
+static esp_err_t write_wr_set(esp_io_expander_ch422g_t *ch422g, uint8_t value)
+{
+    bool was_output = !ch422g->regs_synced || (ch422g->regs.wr_set & REG_WR_SET_BIT_IO_OE);
+
+    ESP_RETURN_ON_ERROR(write_reg(ch422g, CH422G_REG_WR_SET, &ch422g->regs.wr_set, value), TAG, "Write reg failed");
+
+    if (was_output && !(value & REG_WR_SET_BIT_IO_OE)) {
+        ch422g->input_ready_us = esp_timer_get_time() + INPUT_SETTLE_US;
+        if (ch422g->input_ready_cb != NULL) {
+            esp_timer_stop(ch422g->input_ready_timer);
+            ESP_RETURN_ON_ERROR(
+                esp_timer_start_once(ch422g->input_ready_timer, INPUT_SETTLE_US), TAG, "Start timer failed"
+            );
+        }
+    }
+
+    return ESP_OK;
+}
+
+static void wait_input_ready(esp_io_expander_ch422g_t *ch422g)
+{
+    int64_t remain_us = ch422g->input_ready_us - esp_timer_get_time();
+
+    // Sleep for the whole ticks and spin for the rest
+    if (remain_us >= portTICK_PERIOD_MS * 1000) {
+        vTaskDelay(remain_us / (portTICK_PERIOD_MS * 1000));
+        remain_us = ch422g->input_ready_us - esp_timer_get_time();
+    }
+    if (remain_us > 0) {
+        esp_rom_delay_us(remain_us);
+    }
+}
+
+static void input_ready_timer_cb(void *arg)
+{
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)arg;
+
+    portENTER_CRITICAL(&ch422g->input_ready_lock);
+    esp_io_expander_ch422g_ready_cb_t callback = ch422g->input_ready_cb;
+    void *user_ctx = ch422g->input_ready_user_ctx;
+    portEXIT_CRITICAL(&ch422g->input_ready_lock);
+
+    if (callback != NULL) {
+        callback(&ch422g->base, user_ctx);
+    }
+}
+
+/**
+ * @brief Wait for the timer callbacks dispatched so far to return
+ *
+ * @note The `esp_timer` task runs the callbacks one by one in the order of their alarms, so the callbacks dispatched
+ *       before have returned once a new timer with no timeout fires
+ */
+static esp_err_t wait_timer_callbacks(void)
+{
+    // Called from a timer callback, which is the only one running
+    if (strcmp(pcTaskGetName(NULL), "esp_timer") == 0) {
+        return ESP_OK;
+    }
+
+    SemaphoreHandle_t done = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(done, ESP_ERR_NO_MEM, TAG, "Create semaphore failed");
+
+    esp_err_t ret = ESP_OK;
+    esp_timer_handle_t fence_timer = NULL;
+    const esp_timer_create_args_t timer_args = {
+        .callback = fence_timer_cb,
+        .arg = done,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "ch422g_fence",
+        .skip_unhandled_events = false,
+    };
+    ESP_GOTO_ON_ERROR(esp_timer_create(&timer_args, &fence_timer), end, TAG, "Create timer failed");
+    ESP_GOTO_ON_ERROR(esp_timer_start_once(fence_timer, 0), end, TAG, "Start timer failed");
+    xSemaphoreTake(done, portMAX_DELAY);
+
+end:
+    if (fence_timer != NULL) {
+        esp_timer_delete(fence_timer);
+    }
+    vSemaphoreDelete(done);
+
+    return ret;
+}
+
+static void fence_timer_cb(void *arg)
+{
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+}
+
+static void auto_sleep_lock(esp_io_expander_ch422g_t *ch422g)
+{
+    if (ch422g->auto_sleep.mutex != NULL) {
+        xSemaphoreTake(ch422g->auto_sleep.mutex, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Record the access and release the device, the sleep timer is armed if it is not running
+ */
+static void auto_sleep_unlock(esp_io_expander_ch422g_t *ch422g)
+{
+    if (ch422g->auto_sleep.mutex == NULL) {
+        return;
+    }
+    if (ch422g->auto_sleep.idle_us > 0) {
+        ch422g->auto_sleep.last_access_us = esp_timer_get_time();
+        if (!ch422g->auto_sleep.is_sleeping && !esp_timer_is_active(ch422g->auto_sleep.timer)) {
+            esp_timer_start_once(ch422g->auto_sleep.timer, ch422g->auto_sleep.idle_us);
+        }
+    }
+    xSemaphoreGive(ch422g->auto_sleep.mutex);
+}
+
+/**
+ * @brief Wake the chip if it is sleeping by the policy, should be called with the lock held
+ */
+static esp_err_t auto_sleep_wake(esp_io_expander_ch422g_t *ch422g)
+{
+    if (!ch422g->auto_sleep.is_sleeping) {
+        return ESP_OK;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    uint8_t data = (uint8_t)(ch422g->regs.wr_set & ~REG_WR_SET_BIT_SLEEP);
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_to_device(ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Write WR_SET reg failed"
+    );
+    ch422g->regs.wr_set = data;
+    auto_sleep_record_wake(ch422g, (uint32_t)(esp_timer_get_time() - start_us));
+
+    return ESP_OK;
+}
+
+static void auto_sleep_record_wake(esp_io_expander_ch422g_t *ch422g, uint32_t latency_us)
+{
+    ch422g->auto_sleep.is_sleeping = false;
+    ch422g->auto_sleep.sleep_time_total_us += esp_timer_get_time() - ch422g->auto_sleep.sleep_start_us;
+    ch422g->auto_sleep.wake_count++;
+    ch422g->auto_sleep.wake_latency_total_us += latency_us;
+    if (latency_us > ch422g->auto_sleep.wake_latency_max_us) {
+        ch422g->auto_sleep.wake_latency_max_us = latency_us;
+    }
+}
+
+static void auto_sleep_timer_cb(void *arg)
+{
+    esp_io_expander_ch422g_t *ch422g = (esp_io_expander_ch422g_t *)arg;
+    int64_t now_us = 0;
+    int64_t idle_end_us = 0;
+    uint8_t data = 0;
+
+    // Not `auto_sleep_unlock()`, the callback is not an access
+    xSemaphoreTake(ch422g->auto_sleep.mutex, portMAX_DELAY);
+    if ((ch422g->auto_sleep.idle_us == 0) || ch422g->auto_sleep.is_sleeping ||
+            (ch422g->regs.wr_set & REG_WR_SET_BIT_SLEEP)) {
+        goto end;
+    }
+
+    now_us = esp_timer_get_time();
+    idle_end_us = ch422g->auto_sleep.last_access_us + ch422g->auto_sleep.idle_us;
+    if (now_us < idle_end_us) {
+        // Accessed since the timer was armed, wait for the rest of the idle time
+        esp_timer_start_once(ch422g->auto_sleep.timer, idle_end_us - now_us);
+        goto end;
+    }
+
+    data = (uint8_t)(ch422g->regs.wr_set | REG_WR_SET_BIT_SLEEP);
+    if (i2c_master_write_to_device(
+                ch422g->i2c_num, CH422G_REG_WR_SET, &data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)
+            ) != ESP_OK) {
+        ESP_LOGE(TAG, "Enter sleep failed");
+        goto end;
+    }
+    ch422g->regs.wr_set = data;
+    ch422g->auto_sleep.is_sleeping = true;
+    ch422g->auto_sleep.sleep_start_us = now_us;
+    ch422g->auto_sleep.sleep_count++;
+
+end:
+    xSemaphoreGive(ch422g->auto_sleep.mutex);
+}
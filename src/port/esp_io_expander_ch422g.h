@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "driver/i2c.h"
@@ -18,7 +19,7 @@ extern "C" {
 #endif
 
 #define ESP_IO_EXPANDER_CH422G_VER_MAJOR    (0)
-#define ESP_IO_EXPANDER_CH422G_VER_MINOR    (1)
+#define ESP_IO_EXPANDER_CH422G_VER_MINOR    (6)
 #define ESP_IO_EXPANDER_CH422G_VER_PATCH    (0)
 
 /**
@@ -44,6 +45,18 @@ esp_err_t esp_io_expander_ch422g_set_oc_open_drain(esp_io_expander_handle_t hand
 
 esp_err_t esp_io_expander_ch422g_set_oc_push_pull(esp_io_expander_handle_t handle);
 
+/**
+ * @brief Set IO0-7 to input mode
+ *
+ * @note This function doesn't wait for IO0-7 to settle (about 2ms). The next input read waits for the remaining time
+ *       if it comes too early, use `esp_io_expander_ch422g_is_input_ready()` or
+ *       `esp_io_expander_ch422g_set_input_ready_callback()` to avoid the wait.
+ *
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
 esp_err_t esp_io_expander_ch422g_set_all_input(esp_io_expander_handle_t handle);
 
 esp_err_t esp_io_expander_ch422g_set_all_output(esp_io_expander_handle_t handle);
@@ -52,6 +65,125 @@ esp_err_t esp_io_expander_ch422g_enter_sleep(esp_io_expander_handle_t handle);
 
 esp_err_t esp_io_expander_ch422g_exit_sleep(esp_io_expander_handle_t handle);
 
+/**
+ * @brief Callback called when IO0-7 are ready to be read after switching to input mode
+ *
+ * @note Called from the `esp_timer` task, should return quickly.
+ */
+typedef void (*esp_io_expander_ch422g_ready_cb_t)(esp_io_expander_handle_t handle, void *user_ctx);
+
+/**
+ * @brief Set the callback called each time IO0-7 are ready to be read after switching to input mode
+ *
+ * @note Once this function returns, the previous callback is no longer running or called, so its context can be
+ *       released. The same applies to `esp_io_expander_del()`.
+ *
+ * @param handle: IO expander handle
+ * @param callback: Callback, NULL to remove
+ * @param user_ctx: User context passed to the callback
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_ch422g_set_input_ready_callback(esp_io_expander_handle_t handle,
+        esp_io_expander_ch422g_ready_cb_t callback, void *user_ctx);
+
+/**
+ * @brief Check whether IO0-7 are in input mode and settled, so that reading them doesn't wait
+ *
+ * @param handle: IO expander handle
+ * @param ready: Returned result
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_ch422g_is_input_ready(esp_io_expander_handle_t handle, bool *ready);
+
+/**
+ * @brief Statistics of the auto sleep
+ */
+typedef struct {
+    uint32_t sleep_count;               /*!< Number of times entering sleep */
+    uint32_t wake_count;                /*!< Number of times woken by an access */
+    uint32_t wake_latency_avg_us;       /*!< Average time added to an access by waking the chip */
+    uint32_t wake_latency_max_us;       /*!< Maximum time added to an access by waking the chip */
+    uint32_t sleep_time_ms;             /*!< Total time in sleep */
+} esp_io_expander_ch422g_sleep_stats_t;
+
+/**
+ * @brief Set the auto sleep policy, the chip enters sleep after being idle for the time and is woken transparently by
+ *        the next access
+ *
+ * @note The chip woken by `esp_io_expander_ch422g_exit_sleep()` or put to sleep by
+ *       `esp_io_expander_ch422g_enter_sleep()` is not affected, which is up to the caller.
+ * @note Should be called before the device is accessed from other tasks.
+ *
+ * @param handle: IO expander handle
+ * @param idle_ms: Idle time before entering sleep, 0 to disable and wake the chip
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_ch422g_set_auto_sleep(esp_io_expander_handle_t handle, uint32_t idle_ms);
+
+/**
+ * @brief Get the statistics of the auto sleep, including the latency added by waking
+ *
+ * @param handle: IO expander handle
+ * @param stats: Returned statistics
+ * @param reset: Reset the statistics after getting them
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_ch422g_get_sleep_stats(esp_io_expander_handle_t handle,
+        esp_io_expander_ch422g_sleep_stats_t *stats, bool reset);
+
+/**
+ * @brief Number of digits multiplexed by the display scan mode
+ */
+#define ESP_IO_EXPANDER_CH422G_DISPLAY_DIGIT_NUM    (4)
+
+/**
+ * @brief Enable the display scan mode, the chip multiplexes up to 4 digits by itself
+ *
+ * @note IO0-7 drive the segments (bit n of the segments is IOn) and OC0-3 drive the common pins of DIG0-3. All digits
+ *       are blanked when enabled.
+ * @note IO0-7 and OC0-3 can't be written by `esp_io_expander_set_level()` until the mode is disabled.
+ *
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_ch422g_enable_display_scan(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Disable the display scan mode, IO0-7 output the segments of DIG0
+ *
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_ch422g_disable_display_scan(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Write the segments of continuous digits, only the changed digits are sent
+ *
+ * @param handle: IO expander handle
+ * @param start_digit: Index of the first digit (0-3)
+ * @param segments: Segments of each digit, bit n is IOn
+ * @param digit_num: Number of digits
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: The display scan mode is not enabled
+ *      - Others: Fail
+ */
+esp_err_t esp_io_expander_ch422g_write_display_digits(esp_io_expander_handle_t handle, uint8_t start_digit,
+        const uint8_t *segments, size_t digit_num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,9 @@
 
 #define IO_COUNT                (8)
 
+/* Values of a stream which can be converted on the stack */
+#define STREAM_STACK_SIZE       (32)
+
 /* Default register value on power-up */
 #define DIR_REG_DEFAULT_VAL     (0xff)
 #define OUT_REG_DEFAULT_VAL     (0xff)
@@ -47,6 +50,8 @@ static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t valu
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
 static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
 static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t write_output_read_input(esp_io_expander_handle_t handle, uint32_t output_value, uint32_t *input_value);
+static esp_err_t write_output_stream(esp_io_expander_handle_t handle, const uint32_t *values, size_t count);
 static esp_err_t reset(esp_io_expander_t *handle);
 static esp_err_t del(esp_io_expander_t *handle);
 
@@ -62,6 +67,7 @@ esp_err_t esp_io_expander_new_i2c_ht8574(i2c_port_t i2c_num, uint32_t i2c_addres
 
     ht8574->base.config.io_count = IO_COUNT;
     ht8574->base.config.flags.dir_out_bit_zero = 1;
+    ht8574->base.config.flags.output_quasi_bidirectional = 1;
     ht8574->i2c_num = i2c_num;
     ht8574->i2c_address = i2c_address;
     ht8574->base.read_input_reg = read_input_reg;
@@ -69,6 +75,8 @@ esp_err_t esp_io_expander_new_i2c_ht8574(i2c_port_t i2c_num, uint32_t i2c_addres
     ht8574->base.read_output_reg = read_output_reg;
     ht8574->base.write_direction_reg = write_direction_reg;
     ht8574->base.read_direction_reg = read_direction_reg;
+    ht8574->base.write_output_read_input = write_output_read_input;
+    ht8574->base.write_output_stream = write_output_stream;
     ht8574->base.del = del;
     ht8574->base.reset = reset;
 
@@ -97,6 +105,47 @@ static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value
     return ESP_OK;
 }
 
+esp_err_t esp_io_expander_ht8574_read_input_burst(esp_io_expander_handle_t handle, uint8_t *samples, size_t count)
+{
+    ESP_RETURN_ON_FALSE(handle && samples && count, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    esp_io_expander_ht8574_t *ht8574 = (esp_io_expander_ht8574_t *)__containerof(handle, esp_io_expander_ht8574_t, base);
+
+    /* Give enough time for the whole burst, about 9 bits per byte even at the lowest standard speed */
+    uint32_t timeout_ms = I2C_TIMEOUT_MS + count / 10;
+    // *INDENT-OFF*
+    ESP_RETURN_ON_ERROR(
+        i2c_master_read_from_device(ht8574->i2c_num, ht8574->i2c_address, samples, count, pdMS_TO_TICKS(timeout_ms)),
+        TAG, "Burst read input failed");
+    // *INDENT-ON*
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_ht8574_read_input_majority(esp_io_expander_handle_t handle, size_t sample_num, uint8_t *value)
+{
+    ESP_RETURN_ON_FALSE(value, ESP_ERR_INVALID_ARG, TAG, "Invalid value");
+    /* An odd number of snapshots never ties */
+    ESP_RETURN_ON_FALSE((sample_num % 2 == 1) && (sample_num <= ESP_IO_EXPANDER_HT8574_MAJORITY_SAMPLES_MAX),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid sample num");
+
+    uint8_t samples[ESP_IO_EXPANDER_HT8574_MAJORITY_SAMPLES_MAX];
+    ESP_RETURN_ON_ERROR(esp_io_expander_ht8574_read_input_burst(handle, samples, sample_num), TAG, "Burst read failed");
+
+    uint8_t high_count[IO_COUNT] = {0};
+    for (size_t i = 0; i < sample_num; i++) {
+        for (int pin = 0; pin < IO_COUNT; pin++) {
+            high_count[pin] += (samples[i] >> pin) & 1;
+        }
+    }
+    uint8_t result = 0;
+    for (int pin = 0; pin < IO_COUNT; pin++) {
+        if (high_count[pin] * 2 > sample_num) {
+            result |= BIT(pin);
+        }
+    }
+    *value = result;
+    return ESP_OK;
+}
+
 static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value)
 {
     esp_io_expander_ht8574_t *ht8574 = (esp_io_expander_ht8574_t *)__containerof(handle, esp_io_expander_ht8574_t, base);
@@ -110,6 +159,45 @@ static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t valu
     return ESP_OK;
 }
 
+static esp_err_t write_output_stream(esp_io_expander_handle_t handle, const uint32_t *values, size_t count)
+{
+    esp_io_expander_ht8574_t *ht8574 = (esp_io_expander_ht8574_t *)__containerof(handle, esp_io_expander_ht8574_t, base);
+
+    uint8_t stack_data[STREAM_STACK_SIZE];
+    uint8_t *data = stack_data;
+    if (count > STREAM_STACK_SIZE) {
+        data = (uint8_t *)malloc(count);
+        ESP_RETURN_ON_FALSE(data, ESP_ERR_NO_MEM, TAG, "Malloc stream data failed");
+    }
+    for (size_t i = 0; i < count; i++) {
+        data[i] = (uint8_t)values[i];
+    }
+
+    /* The device latches every byte written onto the port, so all values are sent after a single address byte */
+    esp_err_t ret = ESP_OK;
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    ESP_GOTO_ON_FALSE(cmd, ESP_ERR_NO_MEM, end, TAG, "Create cmd link failed");
+    ESP_GOTO_ON_ERROR(i2c_master_start(cmd), del_cmd, TAG, "Add start failed");
+    ESP_GOTO_ON_ERROR(
+        i2c_master_write_byte(cmd, (ht8574->i2c_address << 1) | I2C_MASTER_WRITE, true), del_cmd, TAG,
+        "Add address failed"
+    );
+    ESP_GOTO_ON_ERROR(i2c_master_write(cmd, data, count, true), del_cmd, TAG, "Add data failed");
+    ESP_GOTO_ON_ERROR(i2c_master_stop(cmd), del_cmd, TAG, "Add stop failed");
+    /* Give enough time for the whole stream, about 9 bits per byte even at the lowest standard speed */
+    ret = i2c_master_cmd_begin(ht8574->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS + count / 10));
+    ESP_GOTO_ON_ERROR(ret, del_cmd, TAG, "Write output stream failed");
+    ht8574->regs.output = data[count - 1];
+
+del_cmd:
+    i2c_cmd_link_delete(cmd);
+end:
+    if (data != stack_data) {
+        free(data);
+    }
+    return ret;
+}
+
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value)
 {
     esp_io_expander_ht8574_t *ht8574 = (esp_io_expander_ht8574_t *)__containerof(handle, esp_io_expander_ht8574_t, base);
@@ -134,6 +222,32 @@ static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *v
     return ESP_OK;
 }
 
+static esp_err_t write_output_read_input(esp_io_expander_handle_t handle, uint32_t output_value, uint32_t *input_value)
+{
+    esp_io_expander_ht8574_t *ht8574 = (esp_io_expander_ht8574_t *)__containerof(handle, esp_io_expander_ht8574_t, base);
+    output_value &= 0xff;
+
+    /* The device has no register address, so just write the port and read it back with a repeated start */
+    uint8_t data = (uint8_t)output_value;
+    uint8_t temp = 0;
+    uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(2)] = {0};
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Create cmd link failed");
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (ht8574->i2c_address << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, data, true);
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (ht8574->i2c_address << 1) | I2C_MASTER_READ, true);
+    i2c_master_read_byte(cmd, &temp, I2C_MASTER_LAST_NACK);
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_master_cmd_begin(ht8574->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write output & read input reg failed");
+    ht8574->regs.output = output_value;
+    *input_value = temp;
+    return ESP_OK;
+}
+
 static esp_err_t reset(esp_io_expander_t *handle)
 {
     ESP_RETURN_ON_ERROR(write_output_reg(handle, OUT_REG_DEFAULT_VAL), TAG, "Write output reg failed");
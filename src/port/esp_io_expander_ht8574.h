@@ -18,7 +18,7 @@ extern "C" {
 #endif
 
 #define ESP_IO_EXPANDER_HT8574_VER_MAJOR    (0)
-#define ESP_IO_EXPANDER_HT8574_VER_MINOR    (1)
+#define ESP_IO_EXPANDER_HT8574_VER_MINOR    (4)
 #define ESP_IO_EXPANDER_HT8574_VER_PATCH    (0)
 
 /**
@@ -58,6 +58,41 @@ esp_err_t esp_io_expander_new_i2c_ht8574(i2c_port_t i2c_num, uint32_t i2c_addres
 #define ESP_IO_EXPANDER_I2C_HT8574_ADDRESS_011    (0x2B)
 #define ESP_IO_EXPANDER_I2C_HT8574_ADDRESS_100    (0x2C)
 
+/**
+ * @brief Maximum number of samples for `esp_io_expander_ht8574_read_input_majority()`
+ */
+#define ESP_IO_EXPANDER_HT8574_MAJORITY_SAMPLES_MAX   (31)
+
+/**
+ * @brief Read consecutive snapshots of the port in a single I2C read transaction
+ *
+ * @note The chip samples the port again for every byte clocked out, so `count` bytes give `count` snapshots taken at
+ *       the bus speed (one per 9 SCL cycles), without the overhead of the start condition and the address byte.
+ *
+ * @param handle: IO expander handle
+ * @param samples: Array to store the snapshots, every bit represents a pin (HIGH / LOW)
+ * @param count: Number of snapshots to read
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_ht8574_read_input_burst(esp_io_expander_handle_t handle, uint8_t *samples, size_t count);
+
+/**
+ * @brief Read the port by burst sampling and take the majority level of each pin as the result
+ *
+ * @note This can filter out short glitches on the pins
+ *
+ * @param handle: IO expander handle
+ * @param sample_num: Number of snapshots, should be odd and in [1, ESP_IO_EXPANDER_HT8574_MAJORITY_SAMPLES_MAX], so
+ *                    there is always a majority
+ * @param value: Filtered levels, every bit represents a pin (HIGH / LOW)
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_ht8574_read_input_majority(esp_io_expander_handle_t handle, size_t sample_num, uint8_t *value);
+
 
 #ifdef __cplusplus
 }
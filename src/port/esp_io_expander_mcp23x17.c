@@ -0,0 +1,409 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "driver/i2c.h"
+#include "driver/spi_master.h"
+#include "esp_bit_defs.h"
+#include "esp_check.h"
+#include "esp_log.h"
+
+#include "esp_io_expander.h"
+#include "esp_io_expander_mcp23x17.h"
+
+#include "esp_expander_utils.h"
+
+/* Timeout of each I2C communication */
+#define I2C_TIMEOUT_MS          (10)
+
+#define IO_COUNT                (16)
+
+/* Register address of port A (IOCON.BANK = 0), the one of port B follows */
+#define DIRECTION_REG_ADDR      (0x00)
+#define INT_ENABLE_REG_ADDR     (0x04)
+#define IOCON_REG_ADDR          (0x0A)
+#define PULLUP_REG_ADDR         (0x0C)
+#define INT_FLAG_REG_ADDR       (0x0E)
+#define INPUT_REG_ADDR          (0x12)
+#define OUTPUT_REG_ADDR         (0x14)
+
+/* IOCON bits */
+#define IOCON_BIT_MIRROR        (1 << 6)    /* INTA and INTB are internally connected */
+#define IOCON_BIT_SEQOP         (1 << 5)    /* Byte mode, the address pointer toggles between port A and B */
+#define IOCON_BIT_HAEN          (1 << 3)    /* Hardware address of MCP23S17 */
+#define IOCON_BIT_ODR           (1 << 2)    /* Open-drain INT pins */
+#define IOCON_VAL               (IOCON_BIT_MIRROR | IOCON_BIT_SEQOP | IOCON_BIT_HAEN | IOCON_BIT_ODR)
+
+/* Default register value after reset */
+#define DIR_REG_DEFAULT_VAL     (0xffff)
+#define OUT_REG_DEFAULT_VAL     (0x0000)
+#define PULLUP_REG_DEFAULT_VAL  (0x0000)
+#define INT_ENABLE_DEFAULT_VAL  (0xffff)
+
+/* Pins of each 8-bit port */
+#define PORT0_MASK              (0x00ff)
+#define PORT1_MASK              (0xff00)
+
+/* SPI opcode: 0 1 0 0 A2 A1 A0 R/W */
+#define SPI_OPCODE(hw_address)  (0x40 | (((hw_address) & 0x07) << 1))
+#define SPI_OPCODE_READ_BIT     (0x01)
+
+/* Header of a write buffer: SPI opcode (not sent on I2C) and register address */
+#define WRITE_HEADER_SIZE       (2)
+
+/* Number of output stream values written from the stack */
+#define STREAM_STACK_VALUE_NUM  (16)
+
+/**
+ * @brief Device Structure Type
+ */
+typedef struct {
+    esp_io_expander_t base;
+    i2c_port_t i2c_num;
+    uint32_t i2c_address;
+    spi_device_handle_t spi;    /* NULL if on I2C */
+    uint8_t spi_opcode;
+    bool regs_synced;           /* The shadow registers are the same as the chip, changes are only written then */
+    uint16_t int_enable;        /* Interrupts enabled by users, only those of inputs are enabled on the chip */
+    struct {
+        uint16_t direction;
+        uint16_t output;
+        uint16_t pullup;
+        uint16_t int_enable;
+    } regs;
+} esp_io_expander_mcp23x17_t;
+
+static const char *TAG = "mcp23x17";
+
+static esp_err_t new_mcp23x17(esp_io_expander_mcp23x17_t *mcp, esp_io_expander_handle_t *handle);
+static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value);
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t write_output_stream(esp_io_expander_handle_t handle, const uint32_t *values, size_t count);
+static esp_err_t set_pull(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_pull_t pull);
+static esp_err_t set_int_enable(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+static esp_err_t read_int_status(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t reset(esp_io_expander_t *handle);
+static esp_err_t del(esp_io_expander_t *handle);
+static esp_err_t read_regs(esp_io_expander_mcp23x17_t *mcp, uint8_t reg_addr, uint8_t *data, size_t len);
+static esp_err_t write_regs(esp_io_expander_mcp23x17_t *mcp, uint8_t *buf, size_t data_len);
+static esp_err_t write_reg_pair(esp_io_expander_mcp23x17_t *mcp, uint8_t reg_addr, uint16_t *shadow, uint16_t value);
+static esp_err_t update_int_enable(esp_io_expander_mcp23x17_t *mcp);
+
+esp_err_t esp_io_expander_new_i2c_mcp23017(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(i2c_num < I2C_NUM_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid i2c num");
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)calloc(1, sizeof(esp_io_expander_mcp23x17_t));
+    ESP_RETURN_ON_FALSE(mcp, ESP_ERR_NO_MEM, TAG, "Malloc failed");
+
+    mcp->i2c_num = i2c_num;
+    mcp->i2c_address = i2c_address;
+
+    return new_mcp23x17(mcp, handle);
+}
+
+esp_err_t esp_io_expander_new_spi_mcp23s17(spi_host_device_t spi_host, const esp_io_expander_mcp23s17_spi_config_t *config,
+        esp_io_expander_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(config && handle, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(config->hw_address < 8, ESP_ERR_INVALID_ARG, TAG, "Invalid hardware address");
+
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)calloc(1, sizeof(esp_io_expander_mcp23x17_t));
+    ESP_RETURN_ON_FALSE(mcp, ESP_ERR_NO_MEM, TAG, "Malloc failed");
+
+    /* SPI mode 0, the transactions are short, so polling them is faster than queuing */
+    const spi_device_interface_config_t dev_config = {
+        .mode = 0,
+        .clock_speed_hz = config->clk_speed_hz,
+        .spics_io_num = config->cs_io_num,
+        .queue_size = 1,
+    };
+    esp_err_t ret = spi_bus_add_device(spi_host, &dev_config, &mcp->spi);
+    if (ret != ESP_OK) {
+        free(mcp);
+        ESP_RETURN_ON_ERROR(ret, TAG, "Add SPI device failed");
+    }
+    mcp->spi_opcode = SPI_OPCODE(config->hw_address);
+
+    return new_mcp23x17(mcp, handle);
+}
+
+static esp_err_t new_mcp23x17(esp_io_expander_mcp23x17_t *mcp, esp_io_expander_handle_t *handle)
+{
+    ESP_LOGI(TAG, "version: %d.%d.%d", ESP_IO_EXPANDER_MCP23X17_VER_MAJOR, ESP_IO_EXPANDER_MCP23X17_VER_MINOR,
+             ESP_IO_EXPANDER_MCP23X17_VER_PATCH);
+
+    mcp->base.config.io_count = IO_COUNT;
+    mcp->base.config.flags.dir_out_bit_zero = 1;
+    mcp->base.read_input_reg = read_input_reg;
+    mcp->base.read_input_reg_masked = read_input_reg_masked;
+    mcp->base.write_output_reg = write_output_reg;
+    mcp->base.read_output_reg = read_output_reg;
+    mcp->base.write_direction_reg = write_direction_reg;
+    mcp->base.read_direction_reg = read_direction_reg;
+    mcp->base.write_output_stream = write_output_stream;
+    mcp->base.set_pull = set_pull;
+    mcp->base.set_int_enable = set_int_enable;
+    mcp->base.read_int_status = read_int_status;
+    mcp->base.del = del;
+    mcp->base.reset = reset;
+
+    esp_err_t ret = ESP_OK;
+    /* Reset configuration and register status */
+    ESP_GOTO_ON_ERROR(reset(&mcp->base), err, TAG, "Reset failed");
+
+    *handle = &mcp->base;
+    return ESP_OK;
+err:
+    del(&mcp->base);
+    return ret;
+}
+
+static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    uint8_t temp[2] = {0, 0};
+    ESP_RETURN_ON_ERROR(read_regs(mcp, INPUT_REG_ADDR, temp, sizeof(temp)), TAG, "Read input reg failed");
+    *value = (((uint32_t)temp[1]) << 8) | (temp[0]);
+    return ESP_OK;
+}
+
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    if ((pin_num_mask & PORT0_MASK) && (pin_num_mask & PORT1_MASK)) {
+        return read_input_reg(handle, value);
+    }
+
+    /* Only read the port of the pins */
+    bool is_port1 = (pin_num_mask & PORT1_MASK);
+    uint8_t temp = 0;
+    ESP_RETURN_ON_ERROR(read_regs(mcp, INPUT_REG_ADDR + (is_port1 ? 1 : 0), &temp, 1), TAG, "Read input reg failed");
+    *value = is_port1 ? (((uint32_t)temp) << 8) : temp;
+    return ESP_OK;
+}
+
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    ESP_RETURN_ON_ERROR(write_reg_pair(mcp, OUTPUT_REG_ADDR, &mcp->regs.output, value & 0xffff), TAG, "Write output reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    *value = mcp->regs.output;
+    return ESP_OK;
+}
+
+static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    ESP_RETURN_ON_ERROR(
+        write_reg_pair(mcp, DIRECTION_REG_ADDR, &mcp->regs.direction, value & 0xffff), TAG, "Write direction reg failed"
+    );
+    ESP_RETURN_ON_ERROR(update_int_enable(mcp), TAG, "Update interrupt enable reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    *value = mcp->regs.direction;
+    return ESP_OK;
+}
+
+static esp_err_t write_output_stream(esp_io_expander_handle_t handle, const uint32_t *values, size_t count)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    uint8_t stack_buf[WRITE_HEADER_SIZE + STREAM_STACK_VALUE_NUM * 2];
+    uint8_t *buf = stack_buf;
+    if (count > STREAM_STACK_VALUE_NUM) {
+        buf = (uint8_t *)malloc(WRITE_HEADER_SIZE + count * 2);
+        ESP_RETURN_ON_FALSE(buf, ESP_ERR_NO_MEM, TAG, "Malloc stream data failed");
+    }
+
+    /* In byte mode, the address pointer toggles between OLATA and OLATB, so all values follow a single header */
+    buf[1] = OUTPUT_REG_ADDR;
+    for (size_t i = 0; i < count; i++) {
+        buf[WRITE_HEADER_SIZE + i * 2] = values[i] & 0xff;
+        buf[WRITE_HEADER_SIZE + i * 2 + 1] = (values[i] >> 8) & 0xff;
+    }
+    esp_err_t ret = write_regs(mcp, buf, count * 2);
+    if (ret == ESP_OK) {
+        mcp->regs.output = values[count - 1] & 0xffff;
+    }
+    if (buf != stack_buf) {
+        free(buf);
+    }
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write output stream failed");
+    return ESP_OK;
+}
+
+static esp_err_t set_pull(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_pull_t pull)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    ESP_RETURN_ON_FALSE(pull != IO_EXPANDER_PULL_DOWN, ESP_ERR_NOT_SUPPORTED, TAG, "Pull-down not supported");
+
+    uint16_t pullup = mcp->regs.pullup;
+    pullup = (pull == IO_EXPANDER_PULL_UP) ? (pullup | pin_num_mask) : (pullup & ~pin_num_mask);
+    ESP_RETURN_ON_ERROR(write_reg_pair(mcp, PULLUP_REG_ADDR, &mcp->regs.pullup, pullup), TAG, "Write pull-up reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t set_int_enable(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    mcp->int_enable = enable ? (mcp->int_enable | pin_num_mask) : (mcp->int_enable & ~pin_num_mask);
+    ESP_RETURN_ON_ERROR(update_int_enable(mcp), TAG, "Update interrupt enable reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t read_int_status(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    uint8_t temp[2] = {0, 0};
+    ESP_RETURN_ON_ERROR(read_regs(mcp, INT_FLAG_REG_ADDR, temp, sizeof(temp)), TAG, "Read interrupt flag reg failed");
+    *value = (((uint32_t)temp[1]) << 8) | (temp[0]);
+    return ESP_OK;
+}
+
+static esp_err_t reset(esp_io_expander_t *handle)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    /**
+     * The MCP23S17 ignores its hardware address until IOCON.HAEN is set, so IOCON is also written with the address 0,
+     * which reaches all chips sharing the CS pin before they are configured.
+     */
+    uint8_t iocon[WRITE_HEADER_SIZE + 1] = {0, IOCON_REG_ADDR, IOCON_VAL};
+    uint8_t spi_opcode = mcp->spi_opcode;
+    if (mcp->spi && (spi_opcode != SPI_OPCODE(0))) {
+        mcp->spi_opcode = SPI_OPCODE(0);
+        esp_err_t ret = write_regs(mcp, iocon, 1);
+        mcp->spi_opcode = spi_opcode;
+        ESP_RETURN_ON_ERROR(ret, TAG, "Write IOCON reg failed");
+    }
+    ESP_RETURN_ON_ERROR(write_regs(mcp, iocon, 1), TAG, "Write IOCON reg failed");
+
+    /* Write all registers whatever the shadow registers are. The output is written before the direction. */
+    mcp->regs_synced = false;
+    mcp->int_enable = INT_ENABLE_DEFAULT_VAL;
+    ESP_RETURN_ON_ERROR(write_reg_pair(mcp, OUTPUT_REG_ADDR, &mcp->regs.output, OUT_REG_DEFAULT_VAL), TAG, "Write output reg failed");
+    ESP_RETURN_ON_ERROR(write_reg_pair(mcp, DIRECTION_REG_ADDR, &mcp->regs.direction, DIR_REG_DEFAULT_VAL), TAG, "Write direction reg failed");
+    ESP_RETURN_ON_ERROR(write_reg_pair(mcp, PULLUP_REG_ADDR, &mcp->regs.pullup, PULLUP_REG_DEFAULT_VAL), TAG, "Write pull-up reg failed");
+    ESP_RETURN_ON_ERROR(update_int_enable(mcp), TAG, "Update interrupt enable reg failed");
+    mcp->regs_synced = true;
+    return ESP_OK;
+}
+
+static esp_err_t del(esp_io_expander_t *handle)
+{
+    esp_io_expander_mcp23x17_t *mcp = (esp_io_expander_mcp23x17_t *)__containerof(handle, esp_io_expander_mcp23x17_t, base);
+
+    if (mcp->spi) {
+        ESP_RETURN_ON_ERROR(spi_bus_remove_device(mcp->spi), TAG, "Remove SPI device failed");
+    }
+    free(mcp);
+    return ESP_OK;
+}
+
+/**
+ * @brief Read registers of a pair (up to 2 bytes) in a single transaction
+ */
+static esp_err_t read_regs(esp_io_expander_mcp23x17_t *mcp, uint8_t reg_addr, uint8_t *data, size_t len)
+{
+    if (mcp->spi) {
+        spi_transaction_t trans = {
+            .flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA,
+            .length = (WRITE_HEADER_SIZE + len) * 8,
+            .tx_data = {mcp->spi_opcode | SPI_OPCODE_READ_BIT, reg_addr},
+        };
+        ESP_RETURN_ON_ERROR(spi_device_polling_transmit(mcp->spi, &trans), TAG, "Read reg(0x%02x) failed", reg_addr);
+        memcpy(data, &trans.rx_data[WRITE_HEADER_SIZE], len);
+    } else {
+        ESP_RETURN_ON_ERROR(
+            i2c_master_write_read_device(mcp->i2c_num, mcp->i2c_address, &reg_addr, 1, data, len, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+            TAG, "Read reg(0x%02x) failed", reg_addr);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Write registers in a single transaction
+ *
+ * @param buf: The header (`WRITE_HEADER_SIZE` bytes, the register address in the 2nd byte) followed by the data, the
+ *             1st byte is filled with the SPI opcode
+ * @param data_len: Length of the data after the header
+ */
+static esp_err_t write_regs(esp_io_expander_mcp23x17_t *mcp, uint8_t *buf, size_t data_len)
+{
+    if (mcp->spi) {
+        buf[0] = mcp->spi_opcode;
+        spi_transaction_t trans = {
+            .length = (WRITE_HEADER_SIZE + data_len) * 8,
+            .tx_buffer = buf,
+        };
+        ESP_RETURN_ON_ERROR(spi_device_polling_transmit(mcp->spi, &trans), TAG, "Write reg(0x%02x) failed", buf[1]);
+    } else {
+        /* Give enough time for long streams, about 9 bits per byte even at the lowest standard speed */
+        ESP_RETURN_ON_ERROR(
+            i2c_master_write_to_device(mcp->i2c_num, mcp->i2c_address, buf + 1, 1 + data_len,
+                                       pdMS_TO_TICKS(I2C_TIMEOUT_MS + data_len / 10)),
+            TAG, "Write reg(0x%02x) failed", buf[1]);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Write a register pair, only the ports whose value changed are sent
+ */
+static esp_err_t write_reg_pair(esp_io_expander_mcp23x17_t *mcp, uint8_t reg_addr, uint16_t *shadow, uint16_t value)
+{
+    uint16_t changed = mcp->regs_synced ? (*shadow ^ value) : 0xffff;
+    uint8_t buf[WRITE_HEADER_SIZE + 2] = {0, reg_addr, value & 0xff, value >> 8};
+    size_t data_len = 2;
+
+    if (changed == 0) {
+        return ESP_OK;
+    } else if (!(changed & PORT1_MASK)) {
+        data_len = 1;
+    } else if (!(changed & PORT0_MASK)) {
+        buf[1] = reg_addr + 1;
+        buf[2] = value >> 8;
+        data_len = 1;
+    }
+    ESP_RETURN_ON_ERROR(write_regs(mcp, buf, data_len), TAG, "Write reg(0x%02x) failed", buf[1]);
+    *shadow = value;
+    return ESP_OK;
+}
+
+/**
+ * @brief Enable the interrupts enabled by users on the input pins only, so writing outputs doesn't interrupt
+ */
+static esp_err_t update_int_enable(esp_io_expander_mcp23x17_t *mcp)
+{
+    return write_reg_pair(mcp, INT_ENABLE_REG_ADDR, &mcp->regs.int_enable, mcp->int_enable & mcp->regs.direction);
+}
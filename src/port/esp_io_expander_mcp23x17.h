@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP IO expander: MCP23017 (I2C) and MCP23S17 (SPI)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "driver/i2c.h"
+#include "driver/spi_master.h"
+#include "esp_err.h"
+
+#include "esp_io_expander.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_IO_EXPANDER_MCP23X17_VER_MAJOR    (1)
+#define ESP_IO_EXPANDER_MCP23X17_VER_MINOR    (0)
+#define ESP_IO_EXPANDER_MCP23X17_VER_PATCH    (0)
+
+#define ESP_IO_EXPANDER_MCP23S17_SPI_CLK_SPEED_DEFAULT  (10 * 1000 * 1000)
+
+/**
+ * @brief SPI device configuration of the MCP23S17
+ */
+typedef struct {
+    int cs_io_num;          /*!< GPIO number of the CS pin */
+    int clk_speed_hz;       /*!< SPI clock speed, up to 10MHz */
+    uint8_t hw_address;     /*!< Hardware address (0-7) set by A2-A0 pins, several chips can share a CS pin */
+} esp_io_expander_mcp23s17_spi_config_t;
+
+/**
+ * @brief Default SPI device configuration of the MCP23S17
+ */
+#define ESP_IO_EXPANDER_MCP23S17_SPI_CONFIG_DEFAULT(cs_io) \
+    { \
+        .cs_io_num = cs_io, \
+        .clk_speed_hz = ESP_IO_EXPANDER_MCP23S17_SPI_CLK_SPEED_DEFAULT, \
+        .hw_address = 0, \
+    }
+
+/**
+ * @brief Create a new MCP23017 IO expander driver
+ *
+ * @note The I2C communication should be initialized before use this function
+ * @note The chip works in byte mode with the registers of port A and B paired, so 16 IOs are read or written in a
+ *       single transaction and an output stream is sent as a single burst to the output latches.
+ * @note After reset, the interrupts of all input IOs are enabled, and INTA / INTB are mirrored and open-drain, so any
+ *       of them can be connected to `esp_io_expander_enable_int()`. Pull-ups are supported by
+ *       `esp_io_expander_set_pull()`, pull-downs aren't.
+ *
+ * @param i2c_num: I2C port num
+ * @param i2c_address: I2C address of chip (\see esp_io_expander_mcp23017_address)
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_new_i2c_mcp23017(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle);
+
+/**
+ * @brief Create a new MCP23S17 IO expander driver
+ *
+ * @note The SPI bus should be initialized by `spi_bus_initialize()` before use this function, the device is added to
+ *       the bus by this function and removed by `esp_io_expander_del()`
+ * @note The features are the same as the MCP23017, \see esp_io_expander_new_i2c_mcp23017()
+ *
+ * @param spi_host: SPI host
+ * @param config: SPI device configuration
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_new_spi_mcp23s17(spi_host_device_t spi_host, const esp_io_expander_mcp23s17_spi_config_t *config,
+        esp_io_expander_handle_t *handle);
+
+/**
+ * @brief I2C address of the MCP23017
+ *
+ * The 8-bit address format is as follows:
+ *
+ *                (Slave Address)
+ *     ┌─────────────────┷─────────────────┐
+ *  ┌─────┐─────┐─────┐─────┐─────┐─────┐─────┐─────┐
+ *  |  0  |  1  |  0  |  0  | A2  | A1  | A0  | R/W |
+ *  └─────┘─────┘─────┘─────┘─────┘─────┘─────┘─────┘
+ *     └────────┯────────┘     └─────┯──────┘
+ *           (Fixed)        (Hardware Selectable)
+ *
+ * And the 7-bit slave address is the most important data for users.
+ * For example, if a chip's A0,A1,A2 are connected to GND, it's 7-bit slave address is 0100000b(0x20).
+ * Then users can use `ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_000` to init it.
+ */
+enum esp_io_expander_mcp23017_address {
+    ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_000 = 0b0100000,
+    ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_001 = 0b0100001,
+    ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_010 = 0b0100010,
+    ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_011 = 0b0100011,
+    ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_100 = 0b0100100,
+    ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_101 = 0b0100101,
+    ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_110 = 0b0100110,
+    ESP_IO_EXPANDER_I2C_MCP23017_ADDRESS_111 = 0b0100111,
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,406 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "driver/i2c.h"
+#include "esp_bit_defs.h"
+#include "esp_check.h"
+#include "esp_log.h"
+
+#include "esp_io_expander.h"
+#include "esp_io_expander_pcal95xx.h"
+
+#include "esp_expander_utils.h"
+
+/* Timeout of each I2C communication */
+#define I2C_TIMEOUT_MS          (10)
+
+#define PORT_NUM_MAX            (2)
+#define IO_COUNT_PER_PORT       (8)
+#define PORT_MASK               (0xff)
+
+/* Register address, the registers of all ports are contiguous. `n` is the number of ports */
+#define INPUT_REG_ADDR          (0x00)
+#define OUTPUT_REG_ADDR(n)      (n)
+#define DIRECTION_REG_ADDR(n)   (3 * (n))
+#define DRIVE_REG_ADDR(n)       (0x40)
+#define LATCH_REG_ADDR(n)       (0x40 + 2 * (n))
+#define PULL_EN_REG_ADDR(n)     (0x40 + 3 * (n))
+#define PULL_SEL_REG_ADDR(n)    (0x40 + 4 * (n))
+#define INT_MASK_REG_ADDR(n)    (0x40 + 5 * (n))
+#define INT_STATUS_REG_ADDR(n)  (0x40 + 6 * (n))
+
+/* Register value after reset */
+#define DIR_REG_DEFAULT_VAL     (0xff)
+#define OUT_REG_DEFAULT_VAL     (0xff)
+#define DRIVE_REG_DEFAULT_VAL   (0xff)  /* Full drive strength */
+#define LATCH_REG_DEFAULT_VAL   (0x00)
+#define PULL_EN_REG_DEFAULT_VAL (0x00)
+#define PULL_SEL_REG_DEFAULT_VAL (0xff) /* Pull-up once enabled */
+#define INT_MASK_REG_DEFAULT_VAL (0x00) /* Interrupt enabled, as TCA95xx */
+
+/* Each pin takes 2 bits of the output drive strength registers */
+#define DRIVE_BITS_PER_PIN      (2)
+#define DRIVE_PINS_PER_REG      (8 / DRIVE_BITS_PER_PIN)
+
+/* Maximum number of messages in a transaction, all output drive strength registers of 16-bit chips */
+#define MSG_NUM_MAX             (PORT_NUM_MAX * DRIVE_BITS_PER_PIN)
+
+/**
+ * @brief Device Structure Type
+ */
+typedef struct {
+    esp_io_expander_t base;
+    i2c_port_t i2c_num;
+    uint32_t i2c_address;
+    uint8_t port_num;
+    bool regs_synced;           /* The shadow registers are the same as the chip, changes are only written then */
+    struct {
+        uint8_t direction[PORT_NUM_MAX];
+        uint8_t output[PORT_NUM_MAX];
+        uint8_t drive[PORT_NUM_MAX * DRIVE_BITS_PER_PIN];
+        uint8_t latch[PORT_NUM_MAX];
+        uint8_t pull_en[PORT_NUM_MAX];
+        uint8_t pull_sel[PORT_NUM_MAX];
+        uint8_t int_mask[PORT_NUM_MAX];
+    } regs;
+} esp_io_expander_pcal95xx_t;
+
+static const char *TAG = "pcal95xx";
+
+static esp_err_t new_i2c_pcal95xx(i2c_port_t i2c_num, uint32_t i2c_address, uint8_t port_num, esp_io_expander_handle_t *handle);
+static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value);
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t set_pull(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_pull_t pull);
+static esp_err_t set_drive(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_drive_t drive);
+static esp_err_t set_input_latch(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+static esp_err_t set_int_enable(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable);
+static esp_err_t read_int_status(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t reset(esp_io_expander_t *handle);
+static esp_err_t del(esp_io_expander_t *handle);
+static esp_err_t read_regs(esp_io_expander_pcal95xx_t *pcal, uint8_t reg_addr, uint8_t *data, size_t len);
+static esp_err_t write_regs(esp_io_expander_pcal95xx_t *pcal, uint8_t reg_addr, uint8_t *shadow, const uint8_t *value,
+                            size_t len);
+static esp_err_t write_port_regs(esp_io_expander_pcal95xx_t *pcal, uint8_t reg_addr, uint8_t *shadow, uint32_t value);
+
+static inline uint32_t get_port_regs(esp_io_expander_pcal95xx_t *pcal, const uint8_t *regs)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < pcal->port_num; i++) {
+        value |= ((uint32_t)regs[i]) << (i * IO_COUNT_PER_PORT);
+    }
+    return value;
+}
+
+esp_err_t esp_io_expander_new_i2c_pcal95xx_8bit(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle)
+{
+    return new_i2c_pcal95xx(i2c_num, i2c_address, 1, handle);
+}
+
+esp_err_t esp_io_expander_new_i2c_pcal95xx_16bit(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle)
+{
+    return new_i2c_pcal95xx(i2c_num, i2c_address, 2, handle);
+}
+
+static esp_err_t new_i2c_pcal95xx(i2c_port_t i2c_num, uint32_t i2c_address, uint8_t port_num, esp_io_expander_handle_t *handle)
+{
+    ESP_LOGI(TAG, "version: %d.%d.%d", ESP_IO_EXPANDER_PCAL95XX_VER_MAJOR, ESP_IO_EXPANDER_PCAL95XX_VER_MINOR,
+             ESP_IO_EXPANDER_PCAL95XX_VER_PATCH);
+    ESP_RETURN_ON_FALSE(i2c_num < I2C_NUM_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid i2c num");
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)calloc(1, sizeof(esp_io_expander_pcal95xx_t));
+    ESP_RETURN_ON_FALSE(pcal, ESP_ERR_NO_MEM, TAG, "Malloc failed");
+
+    pcal->base.config.io_count = port_num * IO_COUNT_PER_PORT;
+    pcal->base.config.flags.dir_out_bit_zero = 1;
+    pcal->i2c_num = i2c_num;
+    pcal->i2c_address = i2c_address;
+    pcal->port_num = port_num;
+    pcal->base.read_input_reg = read_input_reg;
+    /* A single port can be read alone only if there are several */
+    pcal->base.read_input_reg_masked = (port_num > 1) ? read_input_reg_masked : NULL;
+    pcal->base.write_output_reg = write_output_reg;
+    pcal->base.read_output_reg = read_output_reg;
+    pcal->base.write_direction_reg = write_direction_reg;
+    pcal->base.read_direction_reg = read_direction_reg;
+    pcal->base.set_pull = set_pull;
+    pcal->base.set_drive = set_drive;
+    pcal->base.set_input_latch = set_input_latch;
+    pcal->base.set_int_enable = set_int_enable;
+    pcal->base.read_int_status = read_int_status;
+    pcal->base.del = del;
+    pcal->base.reset = reset;
+
+    esp_err_t ret = ESP_OK;
+    /* Reset configuration and register status */
+    ESP_GOTO_ON_ERROR(reset(&pcal->base), err, TAG, "Reset failed");
+
+    *handle = &pcal->base;
+    return ESP_OK;
+err:
+    free(pcal);
+    return ret;
+}
+
+static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    uint8_t temp[PORT_NUM_MAX] = {0};
+    ESP_RETURN_ON_ERROR(read_regs(pcal, INPUT_REG_ADDR, temp, pcal->port_num), TAG, "Read input reg failed");
+    *value = get_port_regs(pcal, temp);
+    return ESP_OK;
+}
+
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    uint8_t first = 0;
+    uint8_t last = pcal->port_num - 1;
+    while ((first < last) && !((pin_num_mask >> (first * IO_COUNT_PER_PORT)) & PORT_MASK)) {
+        first++;
+    }
+    while ((last > first) && !((pin_num_mask >> (last * IO_COUNT_PER_PORT)) & PORT_MASK)) {
+        last--;
+    }
+
+    /* Only read the ports of the pins, this also clears their interrupt status only */
+    uint8_t temp[PORT_NUM_MAX] = {0};
+    ESP_RETURN_ON_ERROR(
+        read_regs(pcal, INPUT_REG_ADDR + first, &temp[first], last - first + 1), TAG, "Read input reg failed"
+    );
+    *value = get_port_regs(pcal, temp);
+    return ESP_OK;
+}
+
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    ESP_RETURN_ON_ERROR(
+        write_port_regs(pcal, OUTPUT_REG_ADDR(pcal->port_num), pcal->regs.output, value), TAG, "Write output reg failed"
+    );
+    return ESP_OK;
+}
+
+static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    *value = get_port_regs(pcal, pcal->regs.output);
+    return ESP_OK;
+}
+
+static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    ESP_RETURN_ON_ERROR(
+        write_port_regs(pcal, DIRECTION_REG_ADDR(pcal->port_num), pcal->regs.direction, value), TAG,
+        "Write direction reg failed"
+    );
+    return ESP_OK;
+}
+
+static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    *value = get_port_regs(pcal, pcal->regs.direction);
+    return ESP_OK;
+}
+
+static esp_err_t set_pull(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_pull_t pull)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    uint32_t pull_en = get_port_regs(pcal, pcal->regs.pull_en);
+    if (pull == IO_EXPANDER_PULL_NONE) {
+        pull_en &= ~pin_num_mask;
+    } else {
+        /* Select the direction before enabling, so the pins are never pulled to the other side */
+        uint32_t pull_sel = get_port_regs(pcal, pcal->regs.pull_sel);
+        if (pull == IO_EXPANDER_PULL_UP) {
+            pull_sel |= pin_num_mask;
+        } else {
+            pull_sel &= ~pin_num_mask;
+        }
+        ESP_RETURN_ON_ERROR(
+            write_port_regs(pcal, PULL_SEL_REG_ADDR(pcal->port_num), pcal->regs.pull_sel, pull_sel), TAG,
+            "Write pull selection reg failed"
+        );
+        pull_en |= pin_num_mask;
+    }
+    ESP_RETURN_ON_ERROR(
+        write_port_regs(pcal, PULL_EN_REG_ADDR(pcal->port_num), pcal->regs.pull_en, pull_en), TAG,
+        "Write pull enable reg failed"
+    );
+    return ESP_OK;
+}
+
+static esp_err_t set_drive(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_drive_t drive)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    uint8_t value[PORT_NUM_MAX * DRIVE_BITS_PER_PIN];
+    size_t len = pcal->port_num * DRIVE_BITS_PER_PIN;
+    memcpy(value, pcal->regs.drive, len);
+    for (int pin = 0; pin < pcal->port_num * IO_COUNT_PER_PORT; pin++) {
+        if (pin_num_mask & BIT(pin)) {
+            int shift = (pin % DRIVE_PINS_PER_REG) * DRIVE_BITS_PER_PIN;
+            value[pin / DRIVE_PINS_PER_REG] &= ~(0x3 << shift);
+            value[pin / DRIVE_PINS_PER_REG] |= ((uint8_t)drive & 0x3) << shift;
+        }
+    }
+    ESP_RETURN_ON_ERROR(
+        write_regs(pcal, DRIVE_REG_ADDR(pcal->port_num), pcal->regs.drive, value, len), TAG, "Write drive reg failed"
+    );
+    return ESP_OK;
+}
+
+static esp_err_t set_input_latch(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    uint32_t latch = get_port_regs(pcal, pcal->regs.latch);
+    latch = enable ? (latch | pin_num_mask) : (latch & ~pin_num_mask);
+    ESP_RETURN_ON_ERROR(
+        write_port_regs(pcal, LATCH_REG_ADDR(pcal->port_num), pcal->regs.latch, latch), TAG, "Write latch reg failed"
+    );
+    return ESP_OK;
+}
+
+static esp_err_t set_int_enable(esp_io_expander_handle_t handle, uint32_t pin_num_mask, bool enable)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    /* Set 1 to mask the interrupt */
+    uint32_t int_mask = get_port_regs(pcal, pcal->regs.int_mask);
+    int_mask = enable ? (int_mask & ~pin_num_mask) : (int_mask | pin_num_mask);
+    ESP_RETURN_ON_ERROR(
+        write_port_regs(pcal, INT_MASK_REG_ADDR(pcal->port_num), pcal->regs.int_mask, int_mask), TAG,
+        "Write interrupt mask reg failed"
+    );
+    return ESP_OK;
+}
+
+static esp_err_t read_int_status(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    uint8_t temp[PORT_NUM_MAX] = {0};
+    ESP_RETURN_ON_ERROR(
+        read_regs(pcal, INT_STATUS_REG_ADDR(pcal->port_num), temp, pcal->port_num), TAG, "Read interrupt status reg failed"
+    );
+    *value = get_port_regs(pcal, temp);
+    return ESP_OK;
+}
+
+static esp_err_t reset(esp_io_expander_t *handle)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+    uint8_t n = pcal->port_num;
+    uint8_t drive[PORT_NUM_MAX * DRIVE_BITS_PER_PIN];
+    memset(drive, DRIVE_REG_DEFAULT_VAL, sizeof(drive));
+
+    /* Write all registers whatever the shadow registers are. The output is written before the direction. */
+    pcal->regs_synced = false;
+    ESP_RETURN_ON_ERROR(write_port_regs(pcal, OUTPUT_REG_ADDR(n), pcal->regs.output, UINT32_MAX), TAG, "Write output reg failed");
+    ESP_RETURN_ON_ERROR(write_port_regs(pcal, DIRECTION_REG_ADDR(n), pcal->regs.direction, UINT32_MAX), TAG, "Write direction reg failed");
+    ESP_RETURN_ON_ERROR(write_regs(pcal, DRIVE_REG_ADDR(n), pcal->regs.drive, drive, n * DRIVE_BITS_PER_PIN), TAG, "Write drive reg failed");
+    ESP_RETURN_ON_ERROR(write_port_regs(pcal, LATCH_REG_ADDR(n), pcal->regs.latch, 0), TAG, "Write latch reg failed");
+    ESP_RETURN_ON_ERROR(write_port_regs(pcal, PULL_EN_REG_ADDR(n), pcal->regs.pull_en, 0), TAG, "Write pull enable reg failed");
+    ESP_RETURN_ON_ERROR(write_port_regs(pcal, PULL_SEL_REG_ADDR(n), pcal->regs.pull_sel, UINT32_MAX), TAG, "Write pull selection reg failed");
+    ESP_RETURN_ON_ERROR(write_port_regs(pcal, INT_MASK_REG_ADDR(n), pcal->regs.int_mask, 0), TAG, "Write interrupt mask reg failed");
+    pcal->regs_synced = true;
+    return ESP_OK;
+}
+
+static esp_err_t del(esp_io_expander_t *handle)
+{
+    esp_io_expander_pcal95xx_t *pcal = (esp_io_expander_pcal95xx_t *)__containerof(handle, esp_io_expander_pcal95xx_t, base);
+
+    free(pcal);
+    return ESP_OK;
+}
+
+/**
+ * @brief Read contiguous registers, the register pointer of the chip increases after each byte within a register pair
+ */
+static esp_err_t read_regs(esp_io_expander_pcal95xx_t *pcal, uint8_t reg_addr, uint8_t *data, size_t len)
+{
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_read_device(pcal->i2c_num, pcal->i2c_address, &reg_addr, 1, data, len, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Read reg(0x%02x) failed", reg_addr);
+    return ESP_OK;
+}
+
+/**
+ * @brief Write contiguous registers in a single transaction, only the changed ones are sent
+ *
+ * Each changed register takes a message, all chained by repeated starts. On the chips with several ports, both
+ * registers of a pair are sent in one message if both changed.
+ */
+static esp_err_t write_regs(esp_io_expander_pcal95xx_t *pcal, uint8_t reg_addr, uint8_t *shadow, const uint8_t *value,
+                            size_t len)
+{
+    uint8_t data[MSG_NUM_MAX][3];
+    size_t size[MSG_NUM_MAX];
+    size_t msg_num = 0;
+
+    for (size_t i = 0; (i < len) && (msg_num < MSG_NUM_MAX); i++) {
+        if (pcal->regs_synced && (shadow[i] == value[i])) {
+            continue;
+        }
+        data[msg_num][0] = reg_addr + i;
+        data[msg_num][1] = value[i];
+        size[msg_num] = 2;
+        if ((pcal->port_num > 1) && !(i & 1) && (i + 1 < len) && (!pcal->regs_synced || (shadow[i + 1] != value[i + 1]))) {
+            data[msg_num][2] = value[++i];
+            size[msg_num] = 3;
+        }
+        msg_num++;
+    }
+    if (msg_num == 0) {
+        return ESP_OK;
+    }
+
+    uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(MSG_NUM_MAX)] = {0};
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Create cmd link failed");
+    for (size_t i = 0; i < msg_num; i++) {
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, (pcal->i2c_address << 1) | I2C_MASTER_WRITE, true);
+        i2c_master_write(cmd, data[i], size[i], true);
+    }
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_master_cmd_begin(pcal->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write reg(0x%02x) failed", reg_addr);
+    memcpy(shadow, value, len);
+    return ESP_OK;
+}
+
+/**
+ * @brief Write the registers of all ports, every bit of the value represents a pin
+ */
+static esp_err_t write_port_regs(esp_io_expander_pcal95xx_t *pcal, uint8_t reg_addr, uint8_t *shadow, uint32_t value)
+{
+    uint8_t temp[PORT_NUM_MAX];
+    for (int i = 0; i < pcal->port_num; i++) {
+        temp[i] = (value >> (i * IO_COUNT_PER_PORT)) & PORT_MASK;
+    }
+    return write_regs(pcal, reg_addr, shadow, temp, pcal->port_num);
+}
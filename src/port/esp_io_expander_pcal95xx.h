@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "driver/i2c.h"
+#include "esp_err.h"
+
+#include "esp_io_expander.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_IO_EXPANDER_PCAL95XX_VER_MAJOR    (1)
+#define ESP_IO_EXPANDER_PCAL95XX_VER_MINOR    (0)
+#define ESP_IO_EXPANDER_PCAL95XX_VER_PATCH    (0)
+
+/**
+ * @brief Create a new PCAL95XX_8BIT (PCAL9554B, PCAL6408A) IO expander driver
+ *
+ * @note The I2C communication should be initialized before use this function
+ * @note Besides the registers compatible with TCA9554, the "Agile I/O" registers are supported by
+ *       `esp_io_expander_set_pull()`, `esp_io_expander_set_drive()`, `esp_io_expander_set_input_latch()`,
+ *       `esp_io_expander_set_int_enable()` and `esp_io_expander_get_int_status()`. After reset, the interrupts of all
+ *       IOs are enabled, the input latches and pull resistors are disabled.
+ *
+ * @param i2c_num: I2C port num
+ * @param i2c_address: I2C address of chip (\see esp_io_expander_pcal_95xx_address)
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_new_i2c_pcal95xx_8bit(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle);
+
+/**
+ * @brief Create a new PCAL95XX_16BIT (PCAL9555A, PCAL6416A) IO expander driver
+ *
+ * @note The I2C communication should be initialized before use this function
+ * @note Besides the registers compatible with TCA9555, the "Agile I/O" registers are supported as the 8-bit one. Since
+ *       the input port of each 8 IOs can be read alone, an interrupt is serviced by reading the interrupt status and
+ *       then only the input ports of the changed IOs, see `esp_io_expander_check_changes()`.
+ *
+ * @param i2c_num: I2C port num
+ * @param i2c_address: I2C address of chip (\see esp_io_expander_pcal_95xx_address)
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_new_i2c_pcal95xx_16bit(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle);
+
+/**
+ * @brief I2C address of the PCAL9554B, PCAL9555A, PCAL6408A or PCAL6416A
+ *
+ * The 8-bit address format for the PCAL9554B and PCAL9555A is as follows:
+ *
+ *                (Slave Address)
+ *     ┌─────────────────┷─────────────────┐
+ *  ┌─────┐─────┐─────┐─────┐─────┐─────┐─────┐─────┐
+ *  |  0  |  1  |  0  |  0  | A2  | A1  | A0  | R/W |
+ *  └─────┘─────┘─────┘─────┘─────┘─────┘─────┘─────┘
+ *     └────────┯────────┘     └─────┯──────┘
+ *           (Fixed)        (Hardware Selectable)
+ *
+ * The PCAL6408A and PCAL6416A only have an ADDR pin, which selects A0 while A2 and A1 are fixed to 0.
+ *
+ * And the 7-bit slave address is the most important data for users.
+ * For example, if a PCAL9555A chip's A0,A1,A2 are connected to GND, it's 7-bit slave address is 0b0100000.
+ * Then users can use `ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_000` to init it.
+ */
+enum esp_io_expander_pcal_95xx_address {
+    ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_000 = 0b0100000,
+    ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_001 = 0b0100001,
+    ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_010 = 0b0100010,
+    ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_011 = 0b0100011,
+    ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_100 = 0b0100100,
+    ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_101 = 0b0100101,
+    ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_110 = 0b0100110,
+    ESP_IO_EXPANDER_I2C_PCAL95XX_ADDRESS_111 = 0b0100111,
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,254 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "driver/i2c.h"
+#include "esp_bit_defs.h"
+#include "esp_check.h"
+#include "esp_log.h"
+
+#include "esp_io_expander.h"
+#include "esp_io_expander_tca6424.h"
+
+#include "esp_expander_utils.h"
+
+/* Timeout of each I2C communication */
+#define I2C_TIMEOUT_MS          (10)
+
+#define PORT_NUM                (3)
+#define IO_COUNT_PER_PORT       (8)
+#define IO_COUNT                (PORT_NUM * IO_COUNT_PER_PORT)
+#define PORT_MASK               (0xff)
+
+/* Register address, each register has 3 ports */
+#define INPUT_REG_ADDR          (0x00)
+#define OUTPUT_REG_ADDR         (0x04)
+#define DIRECTION_REG_ADDR      (0x0C)
+
+/* Set in the command byte to increase the register pointer after each byte */
+#define AUTO_INCREMENT_BIT      (0x80)
+
+/* Default register value on power-up */
+#define DIR_REG_DEFAULT_VAL     (0xffffff)
+#define OUT_REG_DEFAULT_VAL     (0xffffff)
+
+/**
+ * @brief Device Structure Type
+ */
+typedef struct {
+    esp_io_expander_t base;
+    i2c_port_t i2c_num;
+    uint32_t i2c_address;
+    struct {
+        uint32_t direction;
+        uint32_t output;
+    } regs;
+} esp_io_expander_tca6424_t;
+
+static const char *TAG = "tca6424";
+
+static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value);
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t reset(esp_io_expander_t *handle);
+static esp_err_t del(esp_io_expander_t *handle);
+static esp_err_t read_ports(esp_io_expander_tca6424_t *tca, uint8_t reg_addr, uint32_t pin_num_mask, uint32_t *value);
+static esp_err_t write_ports(esp_io_expander_tca6424_t *tca, uint8_t reg_addr, uint32_t *shadow, uint32_t value);
+
+esp_err_t esp_io_expander_new_i2c_tca6424(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle)
+{
+    ESP_LOGI(TAG, "version: %d.%d.%d", ESP_IO_EXPANDER_TCA6424_VER_MAJOR, ESP_IO_EXPANDER_TCA6424_VER_MINOR,
+             ESP_IO_EXPANDER_TCA6424_VER_PATCH);
+    ESP_RETURN_ON_FALSE(i2c_num < I2C_NUM_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid i2c num");
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)calloc(1, sizeof(esp_io_expander_tca6424_t));
+    ESP_RETURN_ON_FALSE(tca, ESP_ERR_NO_MEM, TAG, "Malloc failed");
+
+    tca->base.config.io_count = IO_COUNT;
+    tca->base.config.flags.dir_out_bit_zero = 1;
+    tca->i2c_num = i2c_num;
+    tca->i2c_address = i2c_address;
+    tca->base.read_input_reg = read_input_reg;
+    tca->base.read_input_reg_masked = read_input_reg_masked;
+    tca->base.write_output_reg = write_output_reg;
+    tca->base.read_output_reg = read_output_reg;
+    tca->base.write_direction_reg = write_direction_reg;
+    tca->base.read_direction_reg = read_direction_reg;
+    tca->base.del = del;
+    tca->base.reset = reset;
+
+    esp_err_t ret = ESP_OK;
+    /* Reset configuration and register status */
+    ESP_GOTO_ON_ERROR(reset(&tca->base), err, TAG, "Reset failed");
+
+    *handle = &tca->base;
+    return ESP_OK;
+err:
+    free(tca);
+    return ret;
+}
+
+static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)__containerof(handle, esp_io_expander_tca6424_t, base);
+
+    ESP_RETURN_ON_ERROR(read_ports(tca, INPUT_REG_ADDR, BIT64(IO_COUNT) - 1, value), TAG, "Read input reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value)
+{
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)__containerof(handle, esp_io_expander_tca6424_t, base);
+
+    ESP_RETURN_ON_ERROR(read_ports(tca, INPUT_REG_ADDR, pin_num_mask, value), TAG, "Read input reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)__containerof(handle, esp_io_expander_tca6424_t, base);
+
+    ESP_RETURN_ON_ERROR(write_ports(tca, OUTPUT_REG_ADDR, &tca->regs.output, value), TAG, "Write output reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)__containerof(handle, esp_io_expander_tca6424_t, base);
+
+    *value = tca->regs.output;
+    return ESP_OK;
+}
+
+static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)__containerof(handle, esp_io_expander_tca6424_t, base);
+
+    ESP_RETURN_ON_ERROR(write_ports(tca, DIRECTION_REG_ADDR, &tca->regs.direction, value), TAG, "Write direction reg failed");
+    return ESP_OK;
+}
+
+static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value)
+{
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)__containerof(handle, esp_io_expander_tca6424_t, base);
+
+    *value = tca->regs.direction;
+    return ESP_OK;
+}
+
+static esp_err_t reset(esp_io_expander_t *handle)
+{
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)__containerof(handle, esp_io_expander_tca6424_t, base);
+
+    /* Write all ports of the output and direction registers as 2 messages chained by a repeated start. The output is
+     * written before the direction to avoid glitches on the pins turning into outputs. */
+    uint8_t data[2][1 + PORT_NUM] = {
+        {OUTPUT_REG_ADDR | AUTO_INCREMENT_BIT},
+        {DIRECTION_REG_ADDR | AUTO_INCREMENT_BIT},
+    };
+    for (int i = 0; i < PORT_NUM; i++) {
+        data[0][1 + i] = (OUT_REG_DEFAULT_VAL >> (i * IO_COUNT_PER_PORT)) & PORT_MASK;
+        data[1][1 + i] = (DIR_REG_DEFAULT_VAL >> (i * IO_COUNT_PER_PORT)) & PORT_MASK;
+    }
+    uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(2)] = {0};
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Create cmd link failed");
+    for (int i = 0; i < 2; i++) {
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, (tca->i2c_address << 1) | I2C_MASTER_WRITE, true);
+        i2c_master_write(cmd, data[i], sizeof(data[i]), true);
+    }
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_master_cmd_begin(tca->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write output & direction reg failed");
+    tca->regs.output = OUT_REG_DEFAULT_VAL;
+    tca->regs.direction = DIR_REG_DEFAULT_VAL;
+    return ESP_OK;
+}
+
+static esp_err_t del(esp_io_expander_t *handle)
+{
+    esp_io_expander_tca6424_t *tca = (esp_io_expander_tca6424_t *)__containerof(handle, esp_io_expander_tca6424_t, base);
+
+    free(tca);
+    return ESP_OK;
+}
+
+/**
+ * @brief Get the first and last ports of the pins
+ *
+ * @return false if no pin
+ */
+static bool get_port_span(uint32_t pin_num_mask, int *first, int *last)
+{
+    *first = -1;
+    *last = -1;
+    for (int i = 0; i < PORT_NUM; i++) {
+        if ((pin_num_mask >> (i * IO_COUNT_PER_PORT)) & PORT_MASK) {
+            if (*first < 0) {
+                *first = i;
+            }
+            *last = i;
+        }
+    }
+    return *first >= 0;
+}
+
+/**
+ * @brief Read the span of ports of the pins in a single transaction
+ */
+static esp_err_t read_ports(esp_io_expander_tca6424_t *tca, uint8_t reg_addr, uint32_t pin_num_mask, uint32_t *value)
+{
+    int first, last;
+    if (!get_port_span(pin_num_mask, &first, &last)) {
+        *value = 0;
+        return ESP_OK;
+    }
+
+    uint8_t cmd = (reg_addr + first) | AUTO_INCREMENT_BIT;
+    uint8_t temp[PORT_NUM] = {0};
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_read_device(tca->i2c_num, tca->i2c_address, &cmd, 1, &temp[first], last - first + 1,
+                                     pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Read reg(0x%02x) failed", reg_addr + first);
+    *value = 0;
+    for (int i = first; i <= last; i++) {
+        *value |= ((uint32_t)temp[i]) << (i * IO_COUNT_PER_PORT);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Write the span of the changed ports in a single transaction, nothing is sent if no port changed
+ */
+static esp_err_t write_ports(esp_io_expander_tca6424_t *tca, uint8_t reg_addr, uint32_t *shadow, uint32_t value)
+{
+    value &= BIT64(IO_COUNT) - 1;
+
+    int first, last;
+    if (!get_port_span(*shadow ^ value, &first, &last)) {
+        return ESP_OK;
+    }
+
+    uint8_t data[1 + PORT_NUM] = {(reg_addr + first) | AUTO_INCREMENT_BIT};
+    size_t size = 1;
+    for (int i = first; i <= last; i++) {
+        data[size++] = (value >> (i * IO_COUNT_PER_PORT)) & PORT_MASK;
+    }
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_to_device(tca->i2c_num, tca->i2c_address, data, size, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Write reg(0x%02x) failed", reg_addr + first);
+    *shadow = value;
+    return ESP_OK;
+}
@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP IO expander: TCA6424A
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "driver/i2c.h"
+#include "esp_err.h"
+
+#include "esp_io_expander.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_IO_EXPANDER_TCA6424_VER_MAJOR    (1)
+#define ESP_IO_EXPANDER_TCA6424_VER_MINOR    (0)
+#define ESP_IO_EXPANDER_TCA6424_VER_PATCH    (0)
+
+/**
+ * @brief Create a new TCA6424A IO expander driver
+ *
+ * @note The I2C communication should be initialized before use this function
+ * @note The 3 ports of a register are read or written in a single I2C transaction with the auto-increment of the
+ *       register pointer. Only the span of the changed ports is written, and only the span of the target ports is
+ *       read.
+ *
+ * @param i2c_num: I2C port num
+ * @param i2c_address: I2C address of chip (\see esp_io_expander_tca6424_address)
+ * @param handle: IO expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_new_i2c_tca6424(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle);
+
+/**
+ * @brief I2C address of the TCA6424A
+ *
+ * The 8-bit address format is as follows:
+ *
+ *                (Slave Address)
+ *     ┌─────────────────┷─────────────────┐
+ *  ┌─────┐─────┐─────┐─────┐─────┐─────┐─────┐─────┐
+ *  |  0  |  1  |  0  |  0  |  0  |  1  |ADDR | R/W |
+ *  └─────┘─────┘─────┘─────┘─────┘─────┘─────┘─────┘
+ *     └───────────┯─────────────────┘     └┯┘
+ *              (Fixed)          (Hardware Selectable)
+ *
+ * And the 7-bit slave address is the most important data for users.
+ * For example, if a chip's ADDR is connected to GND, it's 7-bit slave address is 0100010b(0x22).
+ * Then users can use `ESP_IO_EXPANDER_I2C_TCA6424_ADDRESS_0` to init it.
+ */
+enum esp_io_expander_tca6424_address {
+    ESP_IO_EXPANDER_I2C_TCA6424_ADDRESS_0 = 0b0100010,
+    ESP_IO_EXPANDER_I2C_TCA6424_ADDRESS_1 = 0b0100011,
+};
+
+#ifdef __cplusplus
+}
+#endif
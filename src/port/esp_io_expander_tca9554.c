@@ -27,11 +27,15 @@
 #define INPUT_REG_ADDR          (0x00)
 #define OUTPUT_REG_ADDR         (0x01)
 #define DIRECTION_REG_ADDR      (0x03)
+#define REG_ADDR_UNKNOWN        (0xff)
 
 /* Default register value on power-up */
 #define DIR_REG_DEFAULT_VAL     (0xff)
 #define OUT_REG_DEFAULT_VAL     (0xff)
 
+/* Values of a stream sent by each transaction */
+#define STREAM_CHUNK_SIZE       (32)
+
 /**
  * @brief Device Structure Type
  */
@@ -43,6 +47,7 @@ typedef struct {
         uint8_t direction;
         uint8_t output;
     } regs;
+    uint8_t reg_pointer;                /* Register pointed by the last command byte, kept by the device */
 } esp_io_expander_tca9554_t;
 
 static const char *TAG = "tca9554";
@@ -52,6 +57,8 @@ static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t valu
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
 static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
 static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t write_output_read_input(esp_io_expander_handle_t handle, uint32_t output_value, uint32_t *input_value);
+static esp_err_t write_output_stream(esp_io_expander_handle_t handle, const uint32_t *values, size_t count);
 static esp_err_t reset(esp_io_expander_t *handle);
 static esp_err_t del(esp_io_expander_t *handle);
 
@@ -69,11 +76,14 @@ esp_err_t esp_io_expander_new_i2c_tca9554(i2c_port_t i2c_num, uint32_t i2c_addre
     tca9554->base.config.flags.dir_out_bit_zero = 1;
     tca9554->i2c_num = i2c_num;
     tca9554->i2c_address = i2c_address;
+    tca9554->reg_pointer = REG_ADDR_UNKNOWN;
     tca9554->base.read_input_reg = read_input_reg;
     tca9554->base.write_output_reg = write_output_reg;
     tca9554->base.read_output_reg = read_output_reg;
     tca9554->base.write_direction_reg = write_direction_reg;
     tca9554->base.read_direction_reg = read_direction_reg;
+    tca9554->base.write_output_read_input = write_output_read_input;
+    tca9554->base.write_output_stream = write_output_stream;
     tca9554->base.del = del;
     tca9554->base.reset = reset;
 
@@ -93,11 +103,17 @@ static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value
     esp_io_expander_tca9554_t *tca9554 = (esp_io_expander_tca9554_t *)__containerof(handle, esp_io_expander_tca9554_t, base);
 
     uint8_t temp = 0;
-    // *INDENT-OFF*
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_read_device(tca9554->i2c_num, tca9554->i2c_address, (uint8_t[]){INPUT_REG_ADDR}, 1, &temp, 1, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-        TAG, "Read input reg failed");
-    // *INDENT-ON*
+    esp_err_t ret = ESP_OK;
+    if (tca9554->reg_pointer == INPUT_REG_ADDR) {
+        /* Already pointing at the input register, skip the command byte and the repeated start */
+        ret = i2c_master_read_from_device(tca9554->i2c_num, tca9554->i2c_address, &temp, 1, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    } else {
+        // *INDENT-OFF*
+        ret = i2c_master_write_read_device(tca9554->i2c_num, tca9554->i2c_address, (uint8_t[]){INPUT_REG_ADDR}, 1, &temp, 1, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+        // *INDENT-ON*
+    }
+    tca9554->reg_pointer = (ret == ESP_OK) ? INPUT_REG_ADDR : REG_ADDR_UNKNOWN;
+    ESP_RETURN_ON_ERROR(ret, TAG, "Read input reg failed");
     *value = temp;
     return ESP_OK;
 }
@@ -108,13 +124,44 @@ static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t valu
     value &= 0xff;
 
     uint8_t data[] = {OUTPUT_REG_ADDR, value};
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(tca9554->i2c_num, tca9554->i2c_address, data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-        TAG, "Write output reg failed");
+    esp_err_t ret = i2c_master_write_to_device(tca9554->i2c_num, tca9554->i2c_address, data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    tca9554->reg_pointer = (ret == ESP_OK) ? OUTPUT_REG_ADDR : REG_ADDR_UNKNOWN;
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write output reg failed");
     tca9554->regs.output = value;
     return ESP_OK;
 }
 
+static esp_err_t write_output_stream(esp_io_expander_handle_t handle, const uint32_t *values, size_t count)
+{
+    esp_io_expander_tca9554_t *tca9554 = (esp_io_expander_tca9554_t *)__containerof(handle, esp_io_expander_tca9554_t, base);
+
+    /**
+     * The device doesn't keep writing the output register with more data bytes, so every value is a complete write
+     * message. But the messages are chained by repeated starts in a single transaction, which saves the stop
+     * conditions and the overhead of starting a transaction for each value.
+     */
+    uint8_t data[STREAM_CHUNK_SIZE][2];
+    for (size_t offset = 0; offset < count; offset += STREAM_CHUNK_SIZE) {
+        size_t len = (count - offset < STREAM_CHUNK_SIZE) ? (count - offset) : STREAM_CHUNK_SIZE;
+        i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+        ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Create cmd link failed");
+        for (size_t i = 0; i < len; i++) {
+            data[i][0] = OUTPUT_REG_ADDR;
+            data[i][1] = (uint8_t)values[offset + i];
+            i2c_master_start(cmd);
+            i2c_master_write_byte(cmd, (tca9554->i2c_address << 1) | I2C_MASTER_WRITE, true);
+            i2c_master_write(cmd, data[i], sizeof(data[i]), true);
+        }
+        i2c_master_stop(cmd);
+        esp_err_t ret = i2c_master_cmd_begin(tca9554->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS + len / 4));
+        i2c_cmd_link_delete(cmd);
+        tca9554->reg_pointer = (ret == ESP_OK) ? OUTPUT_REG_ADDR : REG_ADDR_UNKNOWN;
+        ESP_RETURN_ON_ERROR(ret, TAG, "Write output stream failed");
+        tca9554->regs.output = data[len - 1][1];
+    }
+    return ESP_OK;
+}
+
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value)
 {
     esp_io_expander_tca9554_t *tca9554 = (esp_io_expander_tca9554_t *)__containerof(handle, esp_io_expander_tca9554_t, base);
@@ -129,9 +176,9 @@ static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t v
     value &= 0xff;
 
     uint8_t data[] = {DIRECTION_REG_ADDR, value};
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(tca9554->i2c_num, tca9554->i2c_address, data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-        TAG, "Write direction reg failed");
+    esp_err_t ret = i2c_master_write_to_device(tca9554->i2c_num, tca9554->i2c_address, data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    tca9554->reg_pointer = (ret == ESP_OK) ? DIRECTION_REG_ADDR : REG_ADDR_UNKNOWN;
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write direction reg failed");
     tca9554->regs.direction = value;
     return ESP_OK;
 }
@@ -144,6 +191,36 @@ static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *v
     return ESP_OK;
 }
 
+static esp_err_t write_output_read_input(esp_io_expander_handle_t handle, uint32_t output_value, uint32_t *input_value)
+{
+    esp_io_expander_tca9554_t *tca9554 = (esp_io_expander_tca9554_t *)__containerof(handle, esp_io_expander_tca9554_t, base);
+    output_value &= 0xff;
+
+    /* Write output register, then point to input register and read it back, all with repeated starts */
+    uint8_t data[] = {OUTPUT_REG_ADDR, output_value};
+    uint8_t temp = 0;
+    uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(3)] = {0};
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Create cmd link failed");
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (tca9554->i2c_address << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write(cmd, data, sizeof(data), true);
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (tca9554->i2c_address << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, INPUT_REG_ADDR, true);
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (tca9554->i2c_address << 1) | I2C_MASTER_READ, true);
+    i2c_master_read_byte(cmd, &temp, I2C_MASTER_LAST_NACK);
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_master_cmd_begin(tca9554->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    tca9554->reg_pointer = (ret == ESP_OK) ? INPUT_REG_ADDR : REG_ADDR_UNKNOWN;
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write output & read input reg failed");
+    tca9554->regs.output = output_value;
+    *input_value = temp;
+    return ESP_OK;
+}
+
 static esp_err_t reset(esp_io_expander_t *handle)
 {
     ESP_RETURN_ON_ERROR(write_direction_reg(handle, DIR_REG_DEFAULT_VAL), TAG, "Write dir reg failed");
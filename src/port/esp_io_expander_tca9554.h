@@ -23,8 +23,8 @@ extern "C" {
 #endif
 
 #define ESP_IO_EXPANDER_TCA9554_VER_MAJOR    (1)
-#define ESP_IO_EXPANDER_TCA9554_VER_MINOR    (0)
-#define ESP_IO_EXPANDER_TCA9554_VER_PATCH    (1)
+#define ESP_IO_EXPANDER_TCA9554_VER_MINOR    (3)
+#define ESP_IO_EXPANDER_TCA9554_VER_PATCH    (0)
 
 /**
  * @brief Create a new TCA9554 IO expander driver
@@ -26,11 +26,17 @@
 /* Register address */
 #define INPUT_REG_ADDR          (0x00)
 #define OUTPUT_REG_ADDR         (0x02)
+#define POLARITY_REG_ADDR       (0x04)
 #define DIRECTION_REG_ADDR      (0x06)
 
 /* Default register value on power-up */
 #define DIR_REG_DEFAULT_VAL     (0xffff)
 #define OUT_REG_DEFAULT_VAL     (0xffff)
+#define POLARITY_REG_DEFAULT_VAL (0x0000)
+
+/* Pins of each 8-bit port */
+#define PORT0_MASK              (0x00ff)
+#define PORT1_MASK              (0xff00)
 
 /**
  * @brief Device Structure Type
@@ -42,6 +48,7 @@ typedef struct {
     struct {
         uint16_t direction;
         uint16_t output;
+        uint16_t polarity;
     } regs;
 } esp_io_expander_tca95xx_16bit_t;
 
@@ -52,6 +59,9 @@ static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t valu
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
 static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
 static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value);
+static esp_err_t write_reg_pair(esp_io_expander_tca95xx_16bit_t *tca, uint8_t reg_addr, uint16_t *shadow, uint16_t value);
+static esp_err_t write_output_read_input(esp_io_expander_handle_t handle, uint32_t output_value, uint32_t *input_value);
 static esp_err_t reset(esp_io_expander_t *handle);
 static esp_err_t del(esp_io_expander_t *handle);
 
@@ -74,6 +84,8 @@ esp_err_t esp_io_expander_new_i2c_tca95xx_16bit(i2c_port_t i2c_num, uint32_t i2c
     tca->base.read_output_reg = read_output_reg;
     tca->base.write_direction_reg = write_direction_reg;
     tca->base.read_direction_reg = read_direction_reg;
+    tca->base.write_output_read_input = write_output_read_input;
+    tca->base.read_input_reg_masked = read_input_reg_masked;
     tca->base.del = del;
     tca->base.reset = reset;
 
@@ -88,6 +100,39 @@ err:
     return ret;
 }
 
+esp_err_t esp_io_expander_tca95xx_16bit_write_config(esp_io_expander_handle_t handle, uint16_t output,
+        uint16_t polarity, uint16_t direction)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_io_expander_tca95xx_16bit_t *tca = (esp_io_expander_tca95xx_16bit_t *)__containerof(handle, esp_io_expander_tca95xx_16bit_t, base);
+
+    /* The register pointer only toggles within a pair, so each pair takes a message, all with repeated starts. The
+     * output is written before the direction to avoid glitches on the pins turning into outputs. */
+    uint8_t data[3][3] = {
+        {OUTPUT_REG_ADDR, output & 0xff, output >> 8},
+        {POLARITY_REG_ADDR, polarity & 0xff, polarity >> 8},
+        {DIRECTION_REG_ADDR, direction & 0xff, direction >> 8},
+    };
+    uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(3)] = {0};
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Create cmd link failed");
+    for (int i = 0; i < 3; i++) {
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, (tca->i2c_address << 1) | I2C_MASTER_WRITE, true);
+        i2c_master_write(cmd, data[i], sizeof(data[i]), true);
+    }
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_master_cmd_begin(tca->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write config regs failed");
+    tca->regs.output = output;
+    tca->regs.polarity = polarity;
+    tca->regs.direction = direction;
+
+    return ESP_OK;
+}
+
 static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value)
 {
     esp_io_expander_tca95xx_16bit_t *tca = (esp_io_expander_tca95xx_16bit_t *)__containerof(handle, esp_io_expander_tca95xx_16bit_t, base);
@@ -102,16 +147,30 @@ static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value
     return ESP_OK;
 }
 
-static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value)
+static esp_err_t read_input_reg_masked(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *value)
 {
     esp_io_expander_tca95xx_16bit_t *tca = (esp_io_expander_tca95xx_16bit_t *)__containerof(handle, esp_io_expander_tca95xx_16bit_t, base);
-    value &= 0xffff;
 
-    uint8_t data[] = {OUTPUT_REG_ADDR, value & 0xff, value >> 8};
+    if ((pin_num_mask & PORT0_MASK) && (pin_num_mask & PORT1_MASK)) {
+        return read_input_reg(handle, value);
+    }
+
+    /* Only read the port of the pins */
+    bool is_port1 = (pin_num_mask & PORT1_MASK);
+    uint8_t reg_addr = INPUT_REG_ADDR + (is_port1 ? 1 : 0);
+    uint8_t temp = 0;
     ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(tca->i2c_num, tca->i2c_address, data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-        TAG, "Write output reg failed");
-    tca->regs.output = value;
+        i2c_master_write_read_device(tca->i2c_num, tca->i2c_address, &reg_addr, 1, &temp, 1, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Read input reg failed");
+    *value = is_port1 ? (((uint32_t)temp) << 8) : temp;
+    return ESP_OK;
+}
+
+static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value)
+{
+    esp_io_expander_tca95xx_16bit_t *tca = (esp_io_expander_tca95xx_16bit_t *)__containerof(handle, esp_io_expander_tca95xx_16bit_t, base);
+
+    ESP_RETURN_ON_ERROR(write_reg_pair(tca, OUTPUT_REG_ADDR, &tca->regs.output, value & 0xffff), TAG, "Write output reg failed");
     return ESP_OK;
 }
 
@@ -126,13 +185,8 @@ static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *valu
 static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value)
 {
     esp_io_expander_tca95xx_16bit_t *tca = (esp_io_expander_tca95xx_16bit_t *)__containerof(handle, esp_io_expander_tca95xx_16bit_t, base);
-    value &= 0xffff;
 
-    uint8_t data[] = {DIRECTION_REG_ADDR, value & 0xff, value >> 8};
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(tca->i2c_num, tca->i2c_address, data, sizeof(data), pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
-        TAG, "Write direction reg failed");
-    tca->regs.direction = value;
+    ESP_RETURN_ON_ERROR(write_reg_pair(tca, DIRECTION_REG_ADDR, &tca->regs.direction, value & 0xffff), TAG, "Write direction reg failed");
     return ESP_OK;
 }
 
@@ -144,10 +198,40 @@ static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *v
     return ESP_OK;
 }
 
+static esp_err_t write_output_read_input(esp_io_expander_handle_t handle, uint32_t output_value, uint32_t *input_value)
+{
+    esp_io_expander_tca95xx_16bit_t *tca = (esp_io_expander_tca95xx_16bit_t *)__containerof(handle, esp_io_expander_tca95xx_16bit_t, base);
+    output_value &= 0xffff;
+
+    /* Write output registers, then point to input registers and read them back, all with repeated starts */
+    uint8_t data[] = {OUTPUT_REG_ADDR, output_value & 0xff, output_value >> 8};
+    uint8_t temp[2] = {0, 0};
+    uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(3)] = {0};
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Create cmd link failed");
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (tca->i2c_address << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write(cmd, data, sizeof(data), true);
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (tca->i2c_address << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, INPUT_REG_ADDR, true);
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (tca->i2c_address << 1) | I2C_MASTER_READ, true);
+    i2c_master_read(cmd, temp, sizeof(temp), I2C_MASTER_LAST_NACK);
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_master_cmd_begin(tca->i2c_num, cmd, pdMS_TO_TICKS(I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    ESP_RETURN_ON_ERROR(ret, TAG, "Write output & read input reg failed");
+    tca->regs.output = output_value;
+    *input_value = (((uint32_t)temp[1]) << 8) | (temp[0]);
+    return ESP_OK;
+}
+
 static esp_err_t reset(esp_io_expander_t *handle)
 {
-    ESP_RETURN_ON_ERROR(write_direction_reg(handle, DIR_REG_DEFAULT_VAL), TAG, "Write dir reg failed");
-    ESP_RETURN_ON_ERROR(write_output_reg(handle, OUT_REG_DEFAULT_VAL), TAG, "Write output reg failed");
+    ESP_RETURN_ON_ERROR(
+        esp_io_expander_tca95xx_16bit_write_config(handle, OUT_REG_DEFAULT_VAL, POLARITY_REG_DEFAULT_VAL, DIR_REG_DEFAULT_VAL),
+        TAG, "Write config regs failed");
     return ESP_OK;
 }
 
@@ -158,3 +242,28 @@ static esp_err_t del(esp_io_expander_t *handle)
     free(tca);
     return ESP_OK;
 }
+
+/**
+ * @brief Write a register pair, only the ports whose value changed are sent
+ */
+static esp_err_t write_reg_pair(esp_io_expander_tca95xx_16bit_t *tca, uint8_t reg_addr, uint16_t *shadow, uint16_t value)
+{
+    uint16_t changed = *shadow ^ value;
+    uint8_t data[3] = {reg_addr, value & 0xff, value >> 8};
+    size_t size = sizeof(data);
+
+    if (changed == 0) {
+        return ESP_OK;
+    } else if (!(changed & PORT1_MASK)) {
+        size = 2;
+    } else if (!(changed & PORT0_MASK)) {
+        data[0] = reg_addr + 1;
+        data[1] = value >> 8;
+        size = 2;
+    }
+    ESP_RETURN_ON_ERROR(
+        i2c_master_write_to_device(tca->i2c_num, tca->i2c_address, data, size, pdMS_TO_TICKS(I2C_TIMEOUT_MS)),
+        TAG, "Write reg(0x%02x) failed", data[0]);
+    *shadow = value;
+    return ESP_OK;
+}
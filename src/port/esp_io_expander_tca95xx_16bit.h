@@ -18,7 +18,7 @@ extern "C" {
 #endif
 
 #define ESP_IO_EXPANDER_TCA95XX_16BIT_VER_MAJOR    (1)
-#define ESP_IO_EXPANDER_TCA95XX_16BIT_VER_MINOR    (0)
+#define ESP_IO_EXPANDER_TCA95XX_16BIT_VER_MINOR    (2)
 #define ESP_IO_EXPANDER_TCA95XX_16BIT_VER_PATCH    (0)
 
 /**
@@ -35,6 +35,23 @@ extern "C" {
  */
 esp_err_t esp_io_expander_new_i2c_tca95xx_16bit(i2c_port_t i2c_num, uint32_t i2c_address, esp_io_expander_handle_t *handle);
 
+/**
+ * @brief Write the output, polarity inversion and configuration registers in a single I2C transaction
+ *
+ * @note The chip only toggles the register pointer within a pair, so the 3 register pairs are sent as 3 messages
+ *       chained by repeated starts. The output is written before the configuration.
+ *
+ * @param handle: IO expander handle
+ * @param output: Value of output registers (port 1 in the high byte)
+ * @param polarity: Value of polarity inversion registers, 1 means inverted input
+ * @param direction: Value of configuration registers, 1 means input
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_tca95xx_16bit_write_config(esp_io_expander_handle_t handle, uint16_t output,
+        uint16_t polarity, uint16_t direction);
+
 /**
  * @brief I2C address of the TCA9539 or TCA9555
  *
@@ -0,0 +1,331 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_rom_sys.h"
+#include "esp_expander_utils.h"
+#include "esp_expander_hd44780.hpp"
+
+#define CMD_CLEAR_DISPLAY       (0x01)
+#define CMD_RETURN_HOME         (0x02)
+#define CMD_ENTRY_MODE_SET      (0x04)
+#define CMD_DISPLAY_CONTROL     (0x08)
+#define CMD_FUNCTION_SET        (0x20)
+#define CMD_SET_CGRAM_ADDR      (0x40)
+#define CMD_SET_DDRAM_ADDR      (0x80)
+
+#define ENTRY_MODE_INCREMENT    (0x02)
+#define DISPLAY_CONTROL_ON      (0x04)
+#define DISPLAY_CONTROL_CURSOR  (0x02)
+#define DISPLAY_CONTROL_BLINK   (0x01)
+#define FUNCTION_SET_2_LINE     (0x08)
+
+#define POWER_ON_DELAY_MS       (50)
+#define INIT_DELAY_1_US         (4500)
+#define INIT_DELAY_2_US         (150)
+#define SLOW_CMD_DELAY_US       (2000)
+
+#define COLUMNS_MAX             (40)
+#define ROWS_MAX                (4)
+#define COLUMNS_MAX_4_ROWS      (20)
+
+namespace esp_expander {
+
+bool HD44780::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_config.columns > 0) && (_config.columns <= COLUMNS_MAX) && (_config.rows > 0) && (_config.rows <= ROWS_MAX),
+        false, "Invalid size(%dx%d)", _config.columns, _config.rows
+    );
+    // Rows 2 and 3 follow rows 0 and 1 in the 40-byte DDRAM lines, so they can't be longer than 20 columns
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_config.rows <= 2) || (_config.columns <= COLUMNS_MAX_4_ROWS), false,
+        "Too many columns(%d) for more than 2 rows (max %d)", _config.columns, COLUMNS_MAX_4_ROWS
+    );
+
+    const uint8_t pins[] = {
+        _config.rs_pin, _config.rw_pin, _config.en_pin, _config.backlight_pin, _config.data_pins[0],
+        _config.data_pins[1], _config.data_pins[2], _config.data_pins[3]
+    };
+    uint32_t pin_mask = 0;
+    for (auto pin : pins) {
+        if (!isPinUsed(pin)) {
+            continue;
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(pin < IO_COUNT_MAX, false, "Invalid pin(%d)", pin);
+        ESP_UTILS_CHECK_FALSE_RETURN(!(pin_mask & BIT(pin)), false, "Pin(%d) is used twice", pin);
+        pin_mask |= BIT(pin);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        isPinUsed(_config.rs_pin) && isPinUsed(_config.en_pin), false, "RS and EN pins should be used"
+    );
+    for (int i = 0; i < 4; i++) {
+        ESP_UTILS_CHECK_FALSE_RETURN(isPinUsed(_config.data_pins[i]), false, "Data pin(D%d) should be used", i + 4);
+    }
+
+    _pin_mask = pin_mask;
+    _rs_level = BIT(_config.rs_pin);
+    _en_level = BIT(_config.en_pin);
+    _backlight_level = 0;
+    for (int nibble = 0; nibble < 16; nibble++) {
+        _nibble_levels[nibble] = 0;
+        for (int i = 0; i < 4; i++) {
+            if (nibble & BIT(i)) {
+                _nibble_levels[nibble] |= BIT(_config.data_pins[i]);
+            }
+        }
+    }
+    _frame.assign(_config.columns * _config.rows, ' ');
+    _shown = _frame;
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiPinModeOutput(_pin_mask, 0), false, "Set pins output failed");
+    vTaskDelay(pdMS_TO_TICKS(POWER_ON_DELAY_MS));
+
+    // Switch to 4-bit mode whatever the current mode is, see the datasheet of HD44780
+    _levels.clear();
+    appendNibble(0x03, false);
+    ESP_UTILS_CHECK_FALSE_RETURN(sendLevels(), false, "Send init nibble failed");
+    esp_rom_delay_us(INIT_DELAY_1_US);
+    appendNibble(0x03, false);
+    ESP_UTILS_CHECK_FALSE_RETURN(sendLevels(), false, "Send init nibble failed");
+    esp_rom_delay_us(INIT_DELAY_2_US);
+    appendNibble(0x03, false);
+    appendNibble(0x02, false);
+    appendByte(CMD_FUNCTION_SET | ((_config.rows > 1) ? FUNCTION_SET_2_LINE : 0), false);
+    _display_control = DISPLAY_CONTROL_ON;
+    appendByte(CMD_DISPLAY_CONTROL | _display_control, false);
+    appendByte(CMD_ENTRY_MODE_SET | ENTRY_MODE_INCREMENT, false);
+    ESP_UTILS_CHECK_FALSE_RETURN(sendLevels(), false, "Send init commands failed");
+
+    ESP_UTILS_CHECK_FALSE_RETURN(clear(), false, "Clear failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(setBacklight(true), false, "Turn on backlight failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool HD44780::command(uint8_t cmd)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_pin_mask != 0, false, "Not begun");
+
+    appendByte(cmd, false);
+    ESP_UTILS_CHECK_FALSE_RETURN(sendLevels(), false, "Send command(0x%02x) failed", cmd);
+    if ((cmd == CMD_CLEAR_DISPLAY) || ((cmd & ~0x01) == CMD_RETURN_HOME)) {
+        esp_rom_delay_us(SLOW_CMD_DELAY_US);
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool HD44780::write(const uint8_t *data, size_t len)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_pin_mask != 0, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN((data != nullptr) || (len == 0), false, "Invalid data");
+
+    if (len == 0) {
+        return true;
+    }
+    for (size_t i = 0; i < len; i++) {
+        appendByte(data[i], true);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(sendLevels(), false, "Send data failed");
+    // The content of the LCD is unknown, so the next flush rewrites all cells
+    _shown_valid = false;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool HD44780::print(const char *text)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(text, false, "Invalid text");
+
+    return write(reinterpret_cast<const uint8_t *>(text), strlen(text));
+}
+
+bool HD44780::clear(void)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(command(CMD_CLEAR_DISPLAY), false, "Clear display failed");
+    _shown.assign(_shown.size(), ' ');
+    _shown_valid = true;
+
+    return true;
+}
+
+bool HD44780::home(void)
+{
+    return command(CMD_RETURN_HOME);
+}
+
+bool HD44780::setCursor(uint8_t col, uint8_t row)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (col < _config.columns) && (row < _config.rows), false, "Invalid position(%d, %d)", col, row
+    );
+
+    return command(CMD_SET_DDRAM_ADDR | getAddress(col, row));
+}
+
+bool HD44780::setDisplay(bool display_on, bool cursor_on, bool blink_on)
+{
+    uint8_t display_control = (display_on ? DISPLAY_CONTROL_ON : 0) | (cursor_on ? DISPLAY_CONTROL_CURSOR : 0) |
+                              (blink_on ? DISPLAY_CONTROL_BLINK : 0);
+    ESP_UTILS_CHECK_FALSE_RETURN(command(CMD_DISPLAY_CONTROL | display_control), false, "Set display control failed");
+    _display_control = display_control;
+
+    return true;
+}
+
+bool HD44780::setBacklight(bool on)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_pin_mask != 0, false, "Not begun");
+
+    if (!isPinUsed(_config.backlight_pin)) {
+        ESP_UTILS_LOGW("Backlight pin is not used");
+        return true;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _expander.digitalWrite(_config.backlight_pin, on ? HIGH : LOW), false, "Set backlight failed"
+    );
+    _backlight_level = on ? BIT(_config.backlight_pin) : 0;
+
+    return true;
+}
+
+bool HD44780::createChar(uint8_t location, const uint8_t charmap[8])
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_pin_mask != 0, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(location < 8, false, "Invalid location(%d)", location);
+    ESP_UTILS_CHECK_NULL_RETURN(charmap, false, "Invalid charmap");
+
+    appendByte(CMD_SET_CGRAM_ADDR | (location << 3), false);
+    for (int i = 0; i < 8; i++) {
+        appendByte(charmap[i] & 0x1F, true);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(sendLevels(), false, "Send charmap failed");
+    // Go back to DDRAM
+    ESP_UTILS_CHECK_FALSE_RETURN(home(), false, "Return home failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool HD44780::drawText(uint8_t col, uint8_t row, const char *text)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_pin_mask != 0, false, "Not begun");
+    ESP_UTILS_CHECK_NULL_RETURN(text, false, "Invalid text");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (col < _config.columns) && (row < _config.rows), false, "Invalid position(%d, %d)", col, row
+    );
+
+    uint8_t *cell = &_frame[row * _config.columns];
+    for (; (col < _config.columns) && (*text != '\0'); col++, text++) {
+        cell[col] = static_cast<uint8_t>(*text);
+    }
+
+    return true;
+}
+
+void HD44780::clearBuffer(void)
+{
+    _frame.assign(_frame.size(), ' ');
+}
+
+bool HD44780::flush(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_pin_mask != 0, false, "Not begun");
+
+    for (uint8_t row = 0; row < _config.rows; row++) {
+        const uint8_t *frame = &_frame[row * _config.columns];
+        const uint8_t *shown = &_shown[row * _config.columns];
+        uint8_t col = 0;
+        while (col < _config.columns) {
+            if (_shown_valid && (frame[col] == shown[col])) {
+                col++;
+                continue;
+            }
+            // Find the end of the run. A single unchanged cell is rewritten, which costs as much as moving the cursor
+            uint8_t end = col + 1;
+            while (end < _config.columns) {
+                if (!_shown_valid || (frame[end] != shown[end])) {
+                    end++;
+                } else if ((end + 1 < _config.columns) && (frame[end + 1] != shown[end + 1])) {
+                    end += 2;
+                } else {
+                    break;
+                }
+            }
+            appendByte(CMD_SET_DDRAM_ADDR | getAddress(col, row), false);
+            for (; col < end; col++) {
+                appendByte(frame[col], true);
+            }
+        }
+    }
+
+    if (!_levels.empty()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(sendLevels(), false, "Send frame failed");
+        _shown = _frame;
+        _shown_valid = true;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+uint8_t HD44780::getAddress(uint8_t col, uint8_t row) const
+{
+    // Rows 2 and 3 of the 4-row LCDs follow rows 0 and 1 in the DDRAM
+    const uint8_t row_offsets[ROWS_MAX] = {0x00, 0x40, _config.columns, static_cast<uint8_t>(0x40 + _config.columns)};
+
+    return row_offsets[row] + col;
+}
+
+void HD44780::appendNibble(uint8_t nibble, bool is_data)
+{
+    uint32_t levels = _nibble_levels[nibble & 0x0F] | (is_data ? _rs_level : 0) | _backlight_level;
+
+    // The data is latched on the falling edge of EN, so it can change with the rising edge, but RS can't
+    if (_levels.empty() || ((_levels.back() & _rs_level) != (levels & _rs_level))) {
+        _levels.push_back(levels);
+    }
+    _levels.push_back(levels | _en_level);
+    _levels.push_back(levels);
+}
+
+void HD44780::appendByte(uint8_t value, bool is_data)
+{
+    appendNibble(value >> 4, is_data);
+    appendNibble(value & 0x0F, is_data);
+}
+
+bool HD44780::sendLevels(void)
+{
+    bool ret = _expander.multiDigitalWriteStream(_pin_mask, _levels.data(), _levels.size());
+    _levels.clear();
+
+    return ret;
+}
+
+} // namespace esp_expander
@@ -0,0 +1,207 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <vector>
+#include "chip/esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The HD44780 character LCD driver over IO expander pins in 4-bit mode, such as the 1602/2004 I2C backpacks
+ *        based on PCF8574 (driven by `HT8574`)
+ *
+ * @note  Each byte is encoded as 4 output levels (high nibble with EN high/low, then low nibble), and a whole string is
+ *        sent by `Base::multiDigitalWriteStream()`. So the chips supporting output streaming (e.g. HT8574) send it in a
+ *        single transaction instead of one per EN edge.
+ * @note  The frame buffer functions (`drawText()`, `flush()`) only rewrite the changed cells of the display.
+ * @note  R/W is always low, the busy flag is never read. Each byte takes longer than the execution time of the LCD at
+ *        the I2C speeds, and the slow commands (clear and home) are followed by a delay.
+ */
+class HD44780 {
+public:
+    constexpr static uint8_t PIN_NONE = 0xFF;
+
+    /**
+     * @brief Configuration for HD44780 object, the default pins are the wiring of the common PCF8574 backpacks
+     */
+    struct Config {
+        uint8_t rs_pin = 0;                 /*!< RS pin (0-31) */
+        uint8_t rw_pin = 1;                 /*!< R/W pin (0-31), always low, `PIN_NONE` if tied to GND */
+        uint8_t en_pin = 2;                 /*!< EN pin (0-31) */
+        uint8_t backlight_pin = 3;          /*!< Backlight pin (0-31), active high, `PIN_NONE` if unused */
+        uint8_t data_pins[4] = {4, 5, 6, 7}; /*!< D4-D7 pins (0-31) */
+        uint8_t columns = 16;               /*!< Number of columns, should be in [1, 40], or [1, 20] if `rows` > 2 */
+        uint8_t rows = 2;                   /*!< Number of rows, should be in [1, 4] */
+    };
+
+    /**
+     * @brief Construct a HD44780 object
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object which the LCD is connected to
+     * @param[in] config   Configuration for the object
+     */
+    HD44780(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Construct a HD44780 object with the default configuration (1602 on a PCF8574 backpack)
+     *
+     * @param[in] expander IO expander object which the LCD is connected to
+     */
+    HD44780(Base &expander): HD44780(expander, Config()) {}
+
+    /**
+     * @brief Set the pins to output mode, initialize the LCD in 4-bit mode, then clear it and turn on the backlight
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void);
+
+    /**
+     * @brief Send a command
+     *
+     * @param[in] cmd Command, such as `0x01` (clear display)
+     *
+     * @return true if success, otherwise false
+     */
+    bool command(uint8_t cmd);
+
+    /**
+     * @brief Write characters at the cursor
+     *
+     * @param[in] data Characters, can be the custom characters 0-7
+     * @param[in] len  Number of characters
+     *
+     * @return true if success, otherwise false
+     */
+    bool write(const uint8_t *data, size_t len);
+
+    /**
+     * @brief Write a string at the cursor
+     *
+     * @param[in] text String
+     *
+     * @return true if success, otherwise false
+     */
+    bool print(const char *text);
+
+    /**
+     * @brief Clear the display and move the cursor home
+     *
+     * @return true if success, otherwise false
+     */
+    bool clear(void);
+
+    /**
+     * @brief Move the cursor home
+     *
+     * @return true if success, otherwise false
+     */
+    bool home(void);
+
+    /**
+     * @brief Move the cursor
+     *
+     * @param[in] col Column, starts from 0
+     * @param[in] row Row, starts from 0
+     *
+     * @return true if success, otherwise false
+     */
+    bool setCursor(uint8_t col, uint8_t row);
+
+    /**
+     * @brief Set the display control
+     *
+     * @param[in] display_on Turn on the display
+     * @param[in] cursor_on  Show the cursor
+     * @param[in] blink_on   Blink the cursor
+     *
+     * @return true if success, otherwise false
+     */
+    bool setDisplay(bool display_on, bool cursor_on = false, bool blink_on = false);
+
+    /**
+     * @brief Turn on or off the backlight
+     *
+     * @param[in] on Turn on the backlight
+     *
+     * @return true if success, otherwise false
+     */
+    bool setBacklight(bool on);
+
+    /**
+     * @brief Define a custom character
+     *
+     * @note  The cursor is moved home after this function.
+     *
+     * @param[in] location Location of the character (0-7)
+     * @param[in] charmap  Pattern of the character, 8 rows of 5 bits
+     *
+     * @return true if success, otherwise false
+     */
+    bool createChar(uint8_t location, const uint8_t charmap[8]);
+
+    /**
+     * @brief Draw a string into the frame buffer, which is shown by `flush()`
+     *
+     * @note  The string is clipped at the end of the row.
+     *
+     * @param[in] col  Column, starts from 0
+     * @param[in] row  Row, starts from 0
+     * @param[in] text String
+     *
+     * @return true if success, otherwise false
+     */
+    bool drawText(uint8_t col, uint8_t row, const char *text);
+
+    /**
+     * @brief Fill the frame buffer with spaces
+     */
+    void clearBuffer(void);
+
+    /**
+     * @brief Write the changed cells of the frame buffer to the LCD in a single stream
+     *
+     * @note  The cursor is left at an undefined position after this function.
+     *
+     * @return true if success, otherwise false
+     */
+    bool flush(void);
+
+private:
+    bool isPinUsed(uint8_t pin) const
+    {
+        return pin != PIN_NONE;
+    }
+
+    uint32_t getPinBit(uint8_t pin) const
+    {
+        return isPinUsed(pin) ? BIT(pin) : 0;
+    }
+
+    uint8_t getAddress(uint8_t col, uint8_t row) const;
+    void appendNibble(uint8_t nibble, bool is_data);
+    void appendByte(uint8_t value, bool is_data);
+    bool sendLevels(void);
+
+    Base &_expander;
+    Config _config;
+    uint32_t _pin_mask = 0;
+    uint32_t _rs_level = 0;
+    uint32_t _en_level = 0;
+    uint32_t _backlight_level = 0;
+    uint32_t _nibble_levels[16] = {};       // Levels of the data pins for each nibble
+    uint8_t _display_control = 0;
+    std::vector<uint32_t> _levels;          // Reused for each transfer
+    std::vector<uint8_t> _frame;            // Frame buffer to show
+    std::vector<uint8_t> _shown;            // Content of the LCD
+    bool _shown_valid = false;
+};
+
+} // namespace esp_expander
@@ -0,0 +1,257 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <new>
+#include "esp_expander_utils.h"
+#include "esp_expander_input_sampler.hpp"
+
+#define TASK_STOP_WAIT_MS       (100)
+
+namespace esp_expander {
+
+InputSampler::~InputSampler()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool InputSampler::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_buffer == nullptr, false, "Already begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_config.period_us > 0, false, "Invalid period");
+    // Keep the default mask meaning "all pins" without warning about the missing ones on every sample
+    _pin_mask = _config.pin_mask & static_cast<uint32_t>(BIT64(_expander.getDeviceHandle()->config.io_count) - 1);
+    ESP_UTILS_CHECK_FALSE_RETURN(_pin_mask != 0, false, "No valid pin to sample");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_config.buffer_size > 0) && (_config.buffer_size <= BIT(30)), false, "Invalid buffer size"
+    );
+
+    // Round up to a power of 2, so the indexes can wrap around freely
+    uint32_t buffer_size = 1;
+    while (buffer_size < _config.buffer_size) {
+        buffer_size <<= 1;
+    }
+    _buffer.reset(new (std::nothrow) Sample[buffer_size]);
+    ESP_UTILS_CHECK_NULL_RETURN(_buffer, false, "Alloc buffer failed");
+    _buffer_mask = buffer_size - 1;
+    _head = 0;
+    _tail = 0;
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = timerCallback,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "expander_sampler",
+        .skip_unhandled_events = true,
+    };
+    ESP_UTILS_CHECK_ERROR_GOTO(esp_timer_create(&timer_args, &_timer), err, "Create timer failed");
+
+    {
+        TaskHandle_t task_handle = nullptr;
+        _task_running = true;
+        BaseType_t ret = xTaskCreatePinnedToCore(
+                             taskEntry, "expander_sampler", _config.task_stack_size, this, _config.task_priority,
+                             &task_handle, (_config.task_core_id < 0) ? tskNO_AFFINITY : _config.task_core_id
+                         );
+        if (ret != pdPASS) {
+            _task_running = false;
+            ESP_UTILS_LOGE("Create sampling task failed");
+            goto err;
+        }
+        _task_handle = task_handle;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+
+err:
+    if (_timer != nullptr) {
+        esp_timer_delete(_timer);
+        _timer = nullptr;
+    }
+    _buffer.reset();
+
+    return false;
+}
+
+bool InputSampler::del(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_is_started) {
+        ESP_UTILS_CHECK_FALSE_RETURN(stop(), false, "Stop failed");
+    }
+
+    if (_task_handle != nullptr) {
+        _task_running = false;
+        xTaskNotifyGive(_task_handle.load());
+        // The task clears its handle right before deleting itself
+        for (int i = 0; (_task_handle != nullptr) && (i < TASK_STOP_WAIT_MS); i++) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_task_handle == nullptr, false, "Wait for sampling task exit timeout");
+    }
+
+    if (_timer != nullptr) {
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(_timer), false, "Delete timer failed");
+        _timer = nullptr;
+    }
+    _buffer.reset();
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool InputSampler::start(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer != nullptr, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_started, false, "Already started");
+
+    resetStats();
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_start_periodic(_timer, _config.period_us), false, "Start timer failed");
+    _is_started = true;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool InputSampler::stop(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_started, false, "Not started");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_stop(_timer), false, "Stop timer failed");
+    _is_started = false;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+size_t InputSampler::drain(Sample *samples, size_t max_samples)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(samples, 0, "Invalid samples");
+    ESP_UTILS_CHECK_FALSE_RETURN(_buffer != nullptr, 0, "Not begun");
+
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    uint32_t head = _head.load(std::memory_order_acquire);
+    size_t count = head - tail;
+    if (count > max_samples) {
+        count = max_samples;
+    }
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = _buffer[(tail + i) & _buffer_mask];
+    }
+    _tail.store(tail + count, std::memory_order_release);
+
+    return count;
+}
+
+InputSampler::Stats InputSampler::getStats(void) const
+{
+    Stats stats = {
+        .sample_count = _sample_count,
+        .overrun_count = _overrun_count.load(),
+        .missed_count = _missed_count,
+        .error_count = _error_count,
+        .rate_hz = 0,
+        .interval_jitter_max_us = _interval_jitter_max_us,
+    };
+    int64_t elapsed_us = esp_timer_get_time() - _start_us;
+    if (_is_started && (elapsed_us > 0)) {
+        stats.rate_hz = static_cast<float>(_sample_count + stats.overrun_count) * 1000000.0f /
+                        static_cast<float>(elapsed_us);
+    }
+
+    return stats;
+}
+
+void InputSampler::timerCallback(void *arg)
+{
+    InputSampler *sampler = static_cast<InputSampler *>(arg);
+
+    // Only notify here to keep the timer task free, the bus is accessed by the sampling task
+    xTaskNotifyGive(sampler->_task_handle.load());
+}
+
+void InputSampler::taskEntry(void *arg)
+{
+    InputSampler *sampler = static_cast<InputSampler *>(arg);
+
+    ESP_UTILS_LOGD("Sampling task start");
+
+    while (true) {
+        uint32_t notify_count = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!sampler->_task_running) {
+            break;
+        }
+        // More than one notification means the previous read took longer than the period
+        if (notify_count > 1) {
+            sampler->_missed_count += notify_count - 1;
+        }
+        sampler->sampleOnce();
+    }
+
+    ESP_UTILS_LOGD("Sampling task exit");
+
+    sampler->_task_handle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void InputSampler::sampleOnce(void)
+{
+    Sample sample = {
+        .timestamp_us = esp_timer_get_time(),
+        .levels = 0,
+    };
+    if (esp_io_expander_get_level(_expander.getDeviceHandle(), _pin_mask, &sample.levels) != ESP_OK) {
+        _error_count++;
+        return;
+    }
+
+    if (_last_sample_us != 0) {
+        int64_t deviation_us = sample.timestamp_us - _last_sample_us - _config.period_us;
+        uint32_t jitter_us = static_cast<uint32_t>((deviation_us < 0) ? -deviation_us : deviation_us);
+        if (jitter_us > _interval_jitter_max_us) {
+            _interval_jitter_max_us = jitter_us;
+        }
+    }
+    _last_sample_us = sample.timestamp_us;
+
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) > _buffer_mask) {
+        _overrun_count++;
+        return;
+    }
+    _buffer[head & _buffer_mask] = sample;
+    _head.store(head + 1, std::memory_order_release);
+    _sample_count++;
+}
+
+void InputSampler::resetStats(void)
+{
+    _start_us = esp_timer_get_time();
+    _last_sample_us = 0;
+    _sample_count = 0;
+    _overrun_count = 0;
+    _missed_count = 0;
+    _error_count = 0;
+    _interval_jitter_max_us = 0;
+}
+
+} // namespace esp_expander
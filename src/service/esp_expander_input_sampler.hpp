@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "chip/esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The sampler which reads the input levels at a fixed rate and records them with timestamps
+ *
+ * @note  The sampling is triggered by an `esp_timer` and done by a dedicated task. Samples are stored in a
+ *        single-producer single-consumer lock-free ring buffer, consumers drain it without touching the bus.
+ * @note  Only one task should call `drain()` at the same time.
+ */
+class InputSampler {
+public:
+    /**
+     * @brief Configuration for InputSampler object
+     */
+    struct Config {
+        uint32_t pin_mask = UINT32_MAX;     /*!< Pins to sample, the bits beyond the pins of the chip are ignored */
+        uint32_t period_us = 1000;          /*!< Sampling period */
+        size_t buffer_size = 1024;          /*!< Number of samples in the ring buffer, rounded up to a power of 2 */
+        int task_priority = 10;             /*!< Priority of the sampling task */
+        int task_stack_size = 3072;         /*!< Stack size of the sampling task */
+        int task_core_id = -1;              /*!< Core of the sampling task, -1 means no affinity */
+    };
+
+    /**
+     * @brief Timestamped sample
+     */
+    struct Sample {
+        int64_t timestamp_us;               /*!< Time when the read starts, from `esp_timer_get_time()` */
+        uint32_t levels;                    /*!< Levels of the sampled pins, every bit represents a pin (HIGH / LOW) */
+    };
+
+    /**
+     * @brief Sampling statistics
+     */
+    struct Stats {
+        uint32_t sample_count;              /*!< Number of samples stored in the buffer */
+        uint32_t overrun_count;             /*!< Number of samples dropped because the buffer is full */
+        uint32_t missed_count;              /*!< Number of periods skipped because the previous read is not done */
+        uint32_t error_count;               /*!< Number of failed reads */
+        float rate_hz;                      /*!< Achieved number of samples per second since started */
+        uint32_t interval_jitter_max_us;    /*!< Maximum deviation between two consecutive samples and the period */
+    };
+
+    /**
+     * @brief Construct a sampler object
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object to sample
+     * @param[in] config   Configuration for the object
+     */
+    InputSampler(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Destruct object. This function will call `del()` to delete the object.
+     */
+    ~InputSampler();
+
+    /**
+     * @brief Allocate the ring buffer and create the timer and the sampling task
+     *
+     * @note  The sampling doesn't start until `start()` is called.
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void);
+
+    /**
+     * @brief Stop sampling and release the resources
+     *
+     * @return true if success, otherwise false
+     */
+    bool del(void);
+
+    /**
+     * @brief Start sampling, the statistics will be reset
+     *
+     * @return true if success, otherwise false
+     */
+    bool start(void);
+
+    /**
+     * @brief Stop sampling, the samples in the buffer are kept
+     *
+     * @return true if success, otherwise false
+     */
+    bool stop(void);
+
+    /**
+     * @brief Move the samples from the ring buffer to the given array, the oldest first
+     *
+     * @param[out] samples     Array to store the samples
+     * @param[in]  max_samples Size of the array
+     *
+     * @return Number of samples moved
+     */
+    size_t drain(Sample *samples, size_t max_samples);
+
+    /**
+     * @brief Get the number of samples in the ring buffer
+     *
+     * @return Number of samples
+     */
+    size_t available(void) const
+    {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the sampling statistics
+     *
+     * @return Statistics
+     */
+    Stats getStats(void) const;
+
+private:
+    static void timerCallback(void *arg);
+    static void taskEntry(void *arg);
+    void sampleOnce(void);
+    void resetStats(void);
+
+    Base &_expander;
+    Config _config;
+    uint32_t _pin_mask = 0;
+    std::unique_ptr<Sample[]> _buffer;
+    uint32_t _buffer_mask = 0;
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _tail{0};
+    esp_timer_handle_t _timer = nullptr;
+    std::atomic<TaskHandle_t> _task_handle{nullptr};
+    std::atomic<bool> _task_running{false};
+    bool _is_started = false;
+
+    int64_t _start_us = 0;
+    int64_t _last_sample_us = 0;
+    uint32_t _sample_count = 0;
+    std::atomic<uint32_t> _overrun_count{0};
+    uint32_t _missed_count = 0;
+    uint32_t _error_count = 0;
+    uint32_t _interval_jitter_max_us = 0;
+};
+
+} // namespace esp_expander
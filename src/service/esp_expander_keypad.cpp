@@ -0,0 +1,321 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_timer.h"
+#include "esp_expander_utils.h"
+#include "esp_expander_keypad.hpp"
+
+#define TASK_STOP_WAIT_MS       (100)
+
+namespace esp_expander {
+
+Keypad::~Keypad()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool Keypad::begin(bool start_task)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_event_queue == nullptr, false, "Already begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        !_config.row_pins.empty() && !_config.col_pins.empty(), false, "Row and column pins should not be empty"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _config.row_pins.size() * _config.col_pins.size() <= KEY_NUM_MAX, false, "Too many keys (max %d)", KEY_NUM_MAX
+    );
+
+    _row_mask = 0;
+    _col_mask = 0;
+    for (auto pin : _config.row_pins) {
+        ESP_UTILS_CHECK_FALSE_RETURN(pin < IO_COUNT_MAX, false, "Invalid row pin(%d)", pin);
+        ESP_UTILS_CHECK_FALSE_RETURN((_row_mask & BIT(pin)) == 0, false, "Pin(%d) is used twice", pin);
+        _row_mask |= BIT(pin);
+    }
+    for (auto pin : _config.col_pins) {
+        ESP_UTILS_CHECK_FALSE_RETURN(pin < IO_COUNT_MAX, false, "Invalid column pin(%d)", pin);
+        ESP_UTILS_CHECK_FALSE_RETURN(((_row_mask | _col_mask) & BIT(pin)) == 0, false, "Pin(%d) is used twice", pin);
+        _col_mask |= BIT(pin);
+    }
+
+    // A high level of quasi-bidirectional outputs is only a weak pull-up, so the inactive rows can stay in output mode.
+    // Otherwise they must be released by switching to input mode, or pressing keys of the same column on two rows
+    // would short a high row to the low one.
+    _row_quasi_bidirectional = _expander.getDeviceHandle()->config.flags.output_quasi_bidirectional;
+    // Precompute the levels of all row pins when each row is active: the active one is low and the others are high
+    _row_levels.clear();
+    for (auto pin : _config.row_pins) {
+        _row_levels.push_back(_row_mask & ~BIT(pin));
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiPinMode(_col_mask, INPUT), false, "Set column pins input failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiPinMode(_row_mask, OUTPUT), false, "Set row pins output failed");
+    if (_row_quasi_bidirectional) {
+        ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiDigitalWrite(_row_mask, HIGH), false, "Set row pins high failed");
+    } else {
+        // Latch the rows low once, then only their directions change while scanning
+        ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiDigitalWrite(_row_mask, LOW), false, "Set row pins low failed");
+        ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiPinMode(_row_mask, INPUT), false, "Release row pins failed");
+    }
+
+    _event_queue = xQueueCreate(_config.event_queue_size, sizeof(Event));
+    ESP_UTILS_CHECK_NULL_RETURN(_event_queue, false, "Create event queue failed");
+
+    _key_state = 0;
+    _last_raw_state = 0;
+    _stable_scans = 0;
+    resetStats();
+
+    if (start_task) {
+        TaskHandle_t task_handle = nullptr;
+        _task_running = true;
+        BaseType_t ret = xTaskCreatePinnedToCore(
+                             taskEntry, "expander_keypad", _config.task_stack_size, this, _config.task_priority,
+                             &task_handle, (_config.task_core_id < 0) ? tskNO_AFFINITY : _config.task_core_id
+                         );
+        if (ret != pdPASS) {
+            _task_running = false;
+            vQueueDelete(_event_queue);
+            _event_queue = nullptr;
+            ESP_UTILS_LOGE("Create scanning task failed");
+            return false;
+        }
+        _task_handle = task_handle;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Keypad::del(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_task_handle != nullptr) {
+        _task_running = false;
+        xTaskNotifyGive(_task_handle.load());
+        // The task clears its handle right before deleting itself
+        for (int i = 0; (_task_handle != nullptr) && (i < TASK_STOP_WAIT_MS); i++) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_task_handle == nullptr, false, "Wait for scanning task exit timeout");
+    }
+
+    if (_event_queue != nullptr) {
+        vQueueDelete(_event_queue);
+        _event_queue = nullptr;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Keypad::scanOnce(void)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_event_queue != nullptr, false, "Not begun");
+
+    int64_t start_us = esp_timer_get_time();
+    bool success = false;
+    uint64_t raw_state = readMatrix(success);
+    ESP_UTILS_CHECK_FALSE_RETURN(success, false, "Read matrix failed");
+
+    // Accept a change only after it keeps stable for enough scans
+    if (raw_state != _last_raw_state) {
+        _last_raw_state = raw_state;
+        _stable_scans = 0;
+    } else if (_stable_scans < UINT8_MAX) {
+        _stable_scans++;
+    }
+
+    uint64_t old_state = _key_state.load();
+    if ((_stable_scans + 1 >= _config.debounce_scans) && (raw_state != old_state)) {
+        uint64_t new_state = raw_state;
+        if (_config.ghost_detection && isGhosting(raw_state)) {
+            // A ghost key looks like a pressed one, so only accept the releases
+            new_state = old_state & raw_state;
+            _ghost_count++;
+        }
+        if (new_state != old_state) {
+            _key_state = new_state;
+            sendEvents(old_state, new_state);
+        }
+    }
+
+    uint32_t scan_time_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    _scan_count++;
+    _scan_time_total_us += scan_time_us;
+    if (scan_time_us > _scan_time_max_us) {
+        _scan_time_max_us = scan_time_us;
+    }
+
+    return true;
+}
+
+bool Keypad::readEvent(Event &event, uint32_t timeout_ms)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_event_queue != nullptr, false, "Not begun");
+
+    return (xQueueReceive(_event_queue, &event, pdMS_TO_TICKS(timeout_ms)) == pdTRUE);
+}
+
+Keypad::Stats Keypad::getStats(void) const
+{
+    Stats stats = {
+        .scan_count = _scan_count,
+        .scan_rate_hz = 0,
+        .scan_time_avg_us = 0,
+        .scan_time_max_us = _scan_time_max_us,
+        .ghost_count = _ghost_count,
+        .event_drop_count = _event_drop_count,
+    };
+    int64_t elapsed_us = esp_timer_get_time() - _stats_start_us;
+    if (elapsed_us > 0) {
+        stats.scan_rate_hz = static_cast<float>(_scan_count) * 1000000.0f / static_cast<float>(elapsed_us);
+    }
+    if (_scan_count > 0) {
+        stats.scan_time_avg_us = static_cast<uint32_t>(_scan_time_total_us / _scan_count);
+    }
+
+    return stats;
+}
+
+void Keypad::resetStats(void)
+{
+    _stats_start_us = esp_timer_get_time();
+    _scan_count = 0;
+    _scan_time_total_us = 0;
+    _scan_time_max_us = 0;
+    _ghost_count = 0;
+    _event_drop_count = 0;
+}
+
+void Keypad::taskEntry(void *arg)
+{
+    Keypad *keypad = static_cast<Keypad *>(arg);
+    TickType_t next_wake_tick = xTaskGetTickCount();
+    TickType_t interval_ticks = pdMS_TO_TICKS(keypad->_config.scan_interval_ms);
+    if (interval_ticks == 0) {
+        interval_ticks = 1;
+    }
+
+    ESP_UTILS_LOGD("Scanning task start");
+
+    while (keypad->_task_running) {
+        if (!keypad->scanOnce()) {
+            ESP_UTILS_LOGE("Scan failed");
+        }
+        // Sleep until the next scan, `del()` wakes the task up by a notification so it never waits for a whole interval
+        next_wake_tick += interval_ticks;
+        TickType_t wait_ticks = next_wake_tick - xTaskGetTickCount();
+        if (wait_ticks <= interval_ticks) {
+            ulTaskNotifyTake(pdTRUE, wait_ticks);
+        } else {
+            // Behind the schedule, scan again right away
+            next_wake_tick = xTaskGetTickCount();
+        }
+    }
+
+    ESP_UTILS_LOGD("Scanning task exit");
+
+    keypad->_task_handle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+uint64_t Keypad::readMatrix(bool &success)
+{
+    auto handle = _expander.getDeviceHandle();
+    size_t col_num = _config.col_pins.size();
+    uint64_t state = 0;
+
+    success = false;
+    for (size_t row = 0; row < _row_levels.size(); row++) {
+        uint32_t col_levels = 0;
+        if (_row_quasi_bidirectional) {
+            ESP_UTILS_CHECK_ERROR_RETURN(
+                esp_io_expander_exchange_level(handle, _row_mask, _row_levels[row], _col_mask, &col_levels), 0,
+                "Scan row(%d) failed", static_cast<int>(row)
+            );
+        } else {
+            uint32_t row_bit = _row_mask & ~_row_levels[row];
+            ESP_UTILS_CHECK_ERROR_RETURN(
+                esp_io_expander_set_dir(handle, row_bit, IO_EXPANDER_OUTPUT), 0, "Drive row(%d) failed",
+                static_cast<int>(row)
+            );
+            esp_err_t ret = esp_io_expander_get_level(handle, _col_mask, &col_levels);
+            ESP_UTILS_CHECK_ERROR_RETURN(
+                esp_io_expander_set_dir(handle, row_bit, IO_EXPANDER_INPUT), 0, "Release row(%d) failed",
+                static_cast<int>(row)
+            );
+            ESP_UTILS_CHECK_ERROR_RETURN(ret, 0, "Scan row(%d) failed", static_cast<int>(row));
+        }
+        // Pressed keys pull the columns low
+        uint32_t pressed = ~col_levels & _col_mask;
+        for (size_t col = 0; (col < col_num) && pressed; col++) {
+            if (pressed & BIT(_config.col_pins[col])) {
+                state |= BIT64(row * col_num + col);
+            }
+        }
+    }
+    success = true;
+
+    return state;
+}
+
+bool Keypad::isGhosting(uint64_t state) const
+{
+    size_t row_num = _config.row_pins.size();
+    size_t col_num = _config.col_pins.size();
+    uint64_t row_bits = BIT64(col_num) - 1;
+
+    // Without diodes, three pressed keys on the corners of a rectangle make the fourth one look pressed. So two rows
+    // sharing two or more pressed columns can't be trusted.
+    for (size_t i = 0; i < row_num; i++) {
+        uint64_t row_i = (state >> (i * col_num)) & row_bits;
+        if (__builtin_popcountll(row_i) < 2) {
+            continue;
+        }
+        for (size_t j = i + 1; j < row_num; j++) {
+            uint64_t row_j = (state >> (j * col_num)) & row_bits;
+            if (__builtin_popcountll(row_i & row_j) >= 2) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void Keypad::sendEvents(uint64_t old_state, uint64_t new_state)
+{
+    size_t col_num = _config.col_pins.size();
+    uint64_t changed = old_state ^ new_state;
+    int64_t now_us = esp_timer_get_time();
+
+    while (changed) {
+        int index = __builtin_ctzll(changed);
+        changed &= changed - 1;
+
+        Event event = {
+            .row = static_cast<uint8_t>(index / col_num),
+            .col = static_cast<uint8_t>(index % col_num),
+            .pressed = (new_state & BIT64(index)) != 0,
+            .timestamp_us = now_us,
+        };
+        if (xQueueSend(_event_queue, &event, 0) != pdTRUE) {
+            _event_drop_count++;
+        }
+    }
+}
+
+} // namespace esp_expander
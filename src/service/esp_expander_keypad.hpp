@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "chip/esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The key matrix scanner based on IO expander pins
+ *
+ * @note  Row pins are driven low one by one while the others are released, column pins are set to input mode and
+ *        must be pulled up (externally if the chip has no internal pull-up). A key pressed pulls its column low.
+ * @note  On chips with quasi-bidirectional outputs (e.g. HT8574), the inactive rows are written high, which is only a
+ *        weak pull-up. Each row is driven and its columns are sampled by `esp_io_expander_exchange_level()` in a
+ *        single transaction, so a scan of N rows only takes N transactions.
+ * @note  On chips with push-pull outputs, the inactive rows are switched to input mode. Each row then takes a
+ *        direction write to drive it, a read of the columns and a direction write to release it.
+ */
+class Keypad {
+public:
+    constexpr static int KEY_NUM_MAX = 64;
+
+    /**
+     * @brief Configuration for Keypad object
+     */
+    struct Config {
+        std::vector<uint8_t> row_pins;      /*!< Row pins (0-31), driven low one by one */
+        std::vector<uint8_t> col_pins;      /*!< Column pins (0-31), read low when a key of the active row is pressed */
+        uint32_t scan_interval_ms = 10;     /*!< Interval between two scans of the scanning task */
+        uint8_t debounce_scans = 2;         /*!< Number of consecutive identical scans before accepting a change */
+        bool ghost_detection = true;        /*!< Ignore new presses when the matrix shows a possible ghost key */
+        size_t event_queue_size = 16;       /*!< Length of the event queue */
+        int task_priority = 5;              /*!< Priority of the scanning task */
+        int task_stack_size = 4096;         /*!< Stack size of the scanning task */
+        int task_core_id = -1;              /*!< Core of the scanning task, -1 means no affinity */
+    };
+
+    /**
+     * @brief Key event
+     */
+    struct Event {
+        uint8_t row;                        /*!< Index of the row in `Config::row_pins` */
+        uint8_t col;                        /*!< Index of the column in `Config::col_pins` */
+        bool pressed;                       /*!< true if pressed, false if released */
+        int64_t timestamp_us;               /*!< Time when the change is accepted, from `esp_timer_get_time()` */
+    };
+
+    /**
+     * @brief Scanning statistics
+     */
+    struct Stats {
+        uint32_t scan_count;                /*!< Number of completed scans */
+        float scan_rate_hz;                 /*!< Average number of scans per second since the last reset */
+        uint32_t scan_time_avg_us;          /*!< Average time spent by one scan */
+        uint32_t scan_time_max_us;          /*!< Maximum time spent by one scan */
+        uint32_t ghost_count;               /*!< Number of scans ignored because of ghost keys */
+        uint32_t event_drop_count;          /*!< Number of events dropped because the queue is full */
+    };
+
+    /**
+     * @brief Construct a keypad object
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object which the key matrix is connected to
+     * @param[in] config   Configuration for the object
+     */
+    Keypad(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Destruct object. This function will call `del()` to delete the object.
+     */
+    ~Keypad();
+
+    /**
+     * @brief Configure the pins, precompute the row outputs and create the event queue
+     *
+     * @param[in] start_task Whether to create a task to scan the matrix periodically. If false, users should call
+     *                       `scanOnce()` by themselves.
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(bool start_task = true);
+
+    /**
+     * @brief Stop the scanning task and release the resources
+     *
+     * @return true if success, otherwise false
+     */
+    bool del(void);
+
+    /**
+     * @brief Scan the whole matrix once and send the accepted changes to the event queue
+     *
+     * @note  Don't call this function while the scanning task is running.
+     *
+     * @return true if success, otherwise false
+     */
+    bool scanOnce(void);
+
+    /**
+     * @brief Receive a key event from the queue
+     *
+     * @param[out] event      Received event
+     * @param[in]  timeout_ms Time to wait for an event
+     *
+     * @return true if an event is received, otherwise false
+     */
+    bool readEvent(Event &event, uint32_t timeout_ms = 0);
+
+    /**
+     * @brief Get the debounced state of all keys
+     *
+     * @return Bitmask of pressed keys, bit index is `row * col_num + col`
+     */
+    uint64_t getKeyState(void) const
+    {
+        return _key_state.load();
+    }
+
+    /**
+     * @brief Get the scanning statistics
+     *
+     * @return Statistics
+     */
+    Stats getStats(void) const;
+
+    /**
+     * @brief Reset the scanning statistics
+     */
+    void resetStats(void);
+
+    /**
+     * @brief Get the event queue, so that users can wait for it with other queues
+     *
+     * @return Queue handle if begun, otherwise nullptr
+     */
+    QueueHandle_t getEventQueue(void) const
+    {
+        return _event_queue;
+    }
+
+private:
+    static void taskEntry(void *arg);
+    uint64_t readMatrix(bool &success);
+    bool isGhosting(uint64_t state) const;
+    void sendEvents(uint64_t old_state, uint64_t new_state);
+
+    Base &_expander;
+    Config _config;
+    uint32_t _row_mask = 0;
+    uint32_t _col_mask = 0;
+    std::vector<uint32_t> _row_levels;
+    bool _row_quasi_bidirectional = false;
+    QueueHandle_t _event_queue = nullptr;
+    std::atomic<TaskHandle_t> _task_handle{nullptr};
+    std::atomic<bool> _task_running{false};
+    std::atomic<uint64_t> _key_state{0};
+    uint64_t _last_raw_state = 0;
+    uint8_t _stable_scans = 0;
+
+    int64_t _stats_start_us = 0;
+    uint32_t _scan_count = 0;
+    uint64_t _scan_time_total_us = 0;
+    uint32_t _scan_time_max_us = 0;
+    uint32_t _ghost_count = 0;
+    uint32_t _event_drop_count = 0;
+};
+
+} // namespace esp_expander
@@ -0,0 +1,308 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cmath>
+#include "esp_expander_utils.h"
+#include "esp_expander_pwm.hpp"
+
+#define TASK_STOP_WAIT_MS       (100)
+#define TIMER_DELAY_MIN_US      (20)
+
+namespace esp_expander {
+
+PWM::~PWM()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool PWM::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer == nullptr, false, "Already begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_config.pins.empty(), false, "Pins should not be empty");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_config.resolution_bits > 0) && (_config.resolution_bits <= RESOLUTION_BITS_MAX), false,
+        "Invalid resolution bits"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(_config.frequency_hz > 0, false, "Invalid frequency");
+
+    _pin_mask = 0;
+    for (auto pin : _config.pins) {
+        ESP_UTILS_CHECK_FALSE_RETURN(pin < IO_COUNT_MAX, false, "Invalid pin(%d)", pin);
+        ESP_UTILS_CHECK_FALSE_RETURN(!(_pin_mask & BIT(pin)), false, "Pin(%d) is used twice", pin);
+        _pin_mask |= BIT(pin);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiPinMode(_pin_mask, OUTPUT), false, "Set pins output failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiDigitalWrite(_pin_mask, LOW), false, "Set pins low failed");
+
+    // A frame has `2^bits - 1` ticks, the slot of bit `n` lasts `2^n` ticks
+    float tick_us = 1000000.0f / _config.frequency_hz / getMaxDuty();
+    for (int bit = 0; bit < _config.resolution_bits; bit++) {
+        _slot_length_us[bit] = static_cast<uint32_t>(lroundf(tick_us * (1UL << bit)));
+        if (_slot_length_us[bit] == 0) {
+            _slot_length_us[bit] = 1;
+        }
+    }
+    ESP_UTILS_LOGD("Shortest slot: %d us", static_cast<int>(_slot_length_us[0]));
+
+    _duties.assign(_config.pins.size(), 0);
+    _slot_levels.fill(0);
+    _duty_changed = false;
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = timerCallback,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "expander_pwm",
+        .skip_unhandled_events = false,
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_create(&timer_args, &_timer), false, "Create timer failed");
+
+    TaskHandle_t task_handle = nullptr;
+    _task_running = true;
+    BaseType_t ret = xTaskCreatePinnedToCore(
+                         taskEntry, "expander_pwm", _config.task_stack_size, this, _config.task_priority,
+                         &task_handle, (_config.task_core_id < 0) ? tskNO_AFFINITY : _config.task_core_id
+                     );
+    if (ret != pdPASS) {
+        _task_running = false;
+        esp_timer_delete(_timer);
+        _timer = nullptr;
+        ESP_UTILS_LOGE("Create writing task failed");
+        return false;
+    }
+    _task_handle = task_handle;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool PWM::del(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_is_started) {
+        ESP_UTILS_CHECK_FALSE_RETURN(stop(), false, "Stop failed");
+    }
+
+    if (_task_handle != nullptr) {
+        _task_running = false;
+        xTaskNotify(_task_handle.load(), SLOT_IDLE, eSetValueWithOverwrite);
+        // The task clears its handle right before deleting itself
+        for (int i = 0; (_task_handle != nullptr) && (i < TASK_STOP_WAIT_MS); i++) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_task_handle == nullptr, false, "Wait for writing task exit timeout");
+    }
+
+    if (_timer != nullptr) {
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(_timer), false, "Delete timer failed");
+        _timer = nullptr;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool PWM::start(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer != nullptr, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_started, false, "Already started");
+
+    resetStats();
+    _pending_slots = 0;
+    _next_slot = 0;
+    _next_slot_start_us = esp_timer_get_time() + TIMER_DELAY_MIN_US;
+    _is_started = true;
+    esp_err_t ret = esp_timer_start_once(_timer, TIMER_DELAY_MIN_US);
+    if (ret != ESP_OK) {
+        _is_started = false;
+        ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Start timer failed");
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool PWM::stop(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_started, false, "Not started");
+
+    // The callback restarts the timer inside the same critical section, so it can't be restarted after this
+    portENTER_CRITICAL(&_lock);
+    _is_started = false;
+    portEXIT_CRITICAL(&_lock);
+    esp_err_t ret = esp_timer_stop(_timer);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (ret == ESP_OK) || (ret == ESP_ERR_INVALID_STATE), false, "Stop timer failed(%s)", esp_err_to_name(ret)
+    );
+    xTaskNotify(_task_handle.load(), SLOT_IDLE, eSetValueWithOverwrite);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool PWM::setDuty(size_t channel, uint32_t duty)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer != nullptr, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(channel < _duties.size(), false, "Invalid channel");
+    ESP_UTILS_CHECK_FALSE_RETURN(duty <= getMaxDuty(), false, "Invalid duty");
+
+    portENTER_CRITICAL(&_lock);
+    _duties[channel] = duty;
+    portEXIT_CRITICAL(&_lock);
+    _duty_changed = true;
+
+    return true;
+}
+
+uint32_t PWM::getDuty(size_t channel) const
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(channel < _duties.size(), 0, "Invalid channel");
+
+    return _duties[channel];
+}
+
+PWM::Stats PWM::getStats(void) const
+{
+    Stats stats = {
+        .frame_count = _frame_count,
+        .frequency_hz = 0,
+        .slot_jitter_max_us = _slot_jitter_max_us,
+        .slot_miss_count = _slot_miss_count,
+        .error_count = _error_count,
+    };
+    int64_t elapsed_us = esp_timer_get_time() - _stats_start_us;
+    if (_is_started && (elapsed_us > 0)) {
+        stats.frequency_hz = static_cast<float>(_frame_count) * 1000000.0f / static_cast<float>(elapsed_us);
+    }
+
+    return stats;
+}
+
+void PWM::resetStats(void)
+{
+    _stats_start_us = esp_timer_get_time();
+    _frame_count = 0;
+    _slot_jitter_max_us = 0;
+    _slot_miss_count = 0;
+    _error_count = 0;
+}
+
+void PWM::timerCallback(void *arg)
+{
+    PWM *pwm = static_cast<PWM *>(arg);
+    uint32_t slot = pwm->_next_slot;
+    int64_t slot_start_us = pwm->_next_slot_start_us;
+    int64_t now_us = esp_timer_get_time();
+
+    // Schedule the next slot from the planned start instead of now, so the latency doesn't accumulate
+    pwm->_slot_start_us[slot] = slot_start_us;
+    pwm->_next_slot = (slot + 1 < pwm->_config.resolution_bits) ? (slot + 1) : 0;
+    pwm->_next_slot_start_us = slot_start_us + pwm->_slot_length_us[slot];
+    int64_t delay_us = pwm->_next_slot_start_us - now_us;
+    if (delay_us < TIMER_DELAY_MIN_US) {
+        delay_us = TIMER_DELAY_MIN_US;
+        pwm->_next_slot_start_us = now_us + delay_us;
+    }
+    if (slot == 0) {
+        pwm->_frame_count++;
+    }
+
+    portENTER_CRITICAL(&pwm->_lock);
+    if (pwm->_is_started) {
+        esp_timer_start_once(pwm->_timer, delay_us);
+        pwm->_pending_slots++;
+        xTaskNotifyFromISR(pwm->_task_handle.load(), slot, eSetValueWithOverwrite, nullptr);
+    }
+    portEXIT_CRITICAL(&pwm->_lock);
+}
+
+void PWM::taskEntry(void *arg)
+{
+    PWM *pwm = static_cast<PWM *>(arg);
+
+    ESP_UTILS_LOGD("Writing task start");
+
+    while (true) {
+        uint32_t slot = SLOT_IDLE;
+        xTaskNotifyWait(0, UINT32_MAX, &slot, portMAX_DELAY);
+        if (!pwm->_task_running) {
+            break;
+        }
+        // Only the latest slot is kept, the others are missed because the previous write took too long
+        uint32_t pending_slots = pwm->_pending_slots.exchange(0);
+        if (pending_slots > 1) {
+            pwm->_slot_miss_count += pending_slots - 1;
+        }
+        pwm->writeSlot(slot);
+    }
+
+    ESP_UTILS_LOGD("Writing task exit");
+
+    pwm->_task_handle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void PWM::updateSlotLevels(void)
+{
+    // Channels are no more than the pins
+    std::array<uint32_t, IO_COUNT_MAX> duties;
+    size_t channel_num = _duties.size();
+    portENTER_CRITICAL(&_lock);
+    for (size_t channel = 0; channel < channel_num; channel++) {
+        duties[channel] = _duties[channel];
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    // All channels share the levels of each slot
+    for (int bit = 0; bit < _config.resolution_bits; bit++) {
+        uint32_t levels = 0;
+        for (size_t channel = 0; channel < channel_num; channel++) {
+            if (duties[channel] & BIT(bit)) {
+                levels |= BIT(_config.pins[channel]);
+            }
+        }
+        _slot_levels[bit] = levels;
+    }
+}
+
+void PWM::writeSlot(uint32_t slot)
+{
+    uint32_t levels = 0;
+    if (slot != SLOT_IDLE) {
+        // Apply the new duties at the start of a frame
+        if ((slot == 0) && _duty_changed.exchange(false)) {
+            updateSlotLevels();
+        }
+        levels = _slot_levels[slot];
+
+        int64_t jitter_us = esp_timer_get_time() - _slot_start_us[slot];
+        if ((jitter_us > 0) && (static_cast<uint32_t>(jitter_us) > _slot_jitter_max_us)) {
+            _slot_jitter_max_us = static_cast<uint32_t>(jitter_us);
+        }
+    }
+
+    if (esp_io_expander_write_output_stream(_expander.getDeviceHandle(), _pin_mask, &levels, 1) != ESP_OK) {
+        _error_count++;
+    }
+}
+
+} // namespace esp_expander
@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "chip/esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The software PWM engine for IO expander outputs, based on bit-angle modulation (BAM)
+ *
+ * @note  A frame is divided into one slot per duty bit, the slot of bit `n` lasts `2^n` ticks. All channels share the
+ *        output register, so each slot takes a single register write whatever the number of channels, and a frame
+ *        only takes `resolution_bits` writes instead of `2^resolution_bits`.
+ * @note  The slots are scheduled by an `esp_timer` and written by a dedicated task. The shortest slot should be longer
+ *        than a register write (about 100us at 400KHz I2C), otherwise the slots will be late or missed, see `Stats`.
+ */
+class PWM {
+public:
+    constexpr static int RESOLUTION_BITS_MAX = 16;
+
+    /**
+     * @brief Configuration for PWM object
+     */
+    struct Config {
+        std::vector<uint8_t> pins;          /*!< Output pins (0-31), one per channel */
+        uint8_t resolution_bits = 6;        /*!< Duty resolution in bits, should be in [1, RESOLUTION_BITS_MAX] */
+        uint32_t frequency_hz = 100;        /*!< Frequency of the frames */
+        int task_priority = 20;             /*!< Priority of the writing task */
+        int task_stack_size = 3072;         /*!< Stack size of the writing task */
+        int task_core_id = -1;              /*!< Core of the writing task, -1 means no affinity */
+    };
+
+    /**
+     * @brief PWM statistics
+     */
+    struct Stats {
+        uint32_t frame_count;               /*!< Number of completed frames */
+        float frequency_hz;                 /*!< Achieved number of frames per second since started */
+        uint32_t slot_jitter_max_us;        /*!< Maximum delay between the scheduled start of a slot and its write */
+        uint32_t slot_miss_count;           /*!< Number of slots skipped because the previous write is not done */
+        uint32_t error_count;               /*!< Number of failed writes */
+    };
+
+    /**
+     * @brief Construct a PWM object
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object which the channels are connected to
+     * @param[in] config   Configuration for the object
+     */
+    PWM(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Destruct object. This function will call `del()` to delete the object.
+     */
+    ~PWM();
+
+    /**
+     * @brief Set the pins to output low, compute the slot lengths and create the timer and the writing task
+     *
+     * @note  The output doesn't start until `start()` is called. All duties are 0 by default.
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void);
+
+    /**
+     * @brief Stop the output and release the resources
+     *
+     * @return true if success, otherwise false
+     */
+    bool del(void);
+
+    /**
+     * @brief Start the output, the statistics will be reset
+     *
+     * @return true if success, otherwise false
+     */
+    bool start(void);
+
+    /**
+     * @brief Stop the output and set all pins low
+     *
+     * @return true if success, otherwise false
+     */
+    bool stop(void);
+
+    /**
+     * @brief Set the duty of a channel, which takes effect from the next frame
+     *
+     * @param[in] channel Index of the channel in `Config::pins`
+     * @param[in] duty    Duty, should be in [0, `getMaxDuty()`]
+     *
+     * @return true if success, otherwise false
+     */
+    bool setDuty(size_t channel, uint32_t duty);
+
+    /**
+     * @brief Get the duty of a channel
+     *
+     * @param[in] channel Index of the channel in `Config::pins`
+     *
+     * @return Duty if the channel is valid, otherwise 0
+     */
+    uint32_t getDuty(size_t channel) const;
+
+    /**
+     * @brief Get the duty of 100%
+     *
+     * @return Maximum duty
+     */
+    uint32_t getMaxDuty(void) const
+    {
+        return (1UL << _config.resolution_bits) - 1;
+    }
+
+    /**
+     * @brief Get the PWM statistics
+     *
+     * @return Statistics
+     */
+    Stats getStats(void) const;
+
+    /**
+     * @brief Reset the PWM statistics
+     */
+    void resetStats(void);
+
+private:
+    constexpr static uint32_t SLOT_IDLE = UINT32_MAX;
+
+    static void timerCallback(void *arg);
+    static void taskEntry(void *arg);
+    void updateSlotLevels(void);
+    void writeSlot(uint32_t slot);
+
+    Base &_expander;
+    Config _config;
+    uint32_t _pin_mask = 0;
+    std::vector<uint32_t> _duties;
+    std::atomic<bool> _duty_changed{false};
+    portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+    std::array<uint32_t, RESOLUTION_BITS_MAX> _slot_levels = {};
+    std::array<uint32_t, RESOLUTION_BITS_MAX> _slot_length_us = {};
+    std::array<int64_t, RESOLUTION_BITS_MAX> _slot_start_us = {};
+    esp_timer_handle_t _timer = nullptr;
+    std::atomic<TaskHandle_t> _task_handle{nullptr};
+    std::atomic<bool> _task_running{false};
+    std::atomic<uint32_t> _pending_slots{0};
+    bool _is_started = false;
+
+    // Only accessed by the timer callback
+    uint32_t _next_slot = 0;
+    int64_t _next_slot_start_us = 0;
+
+    int64_t _stats_start_us = 0;
+    uint32_t _frame_count = 0;
+    uint32_t _slot_jitter_max_us = 0;
+    uint32_t _slot_miss_count = 0;
+    uint32_t _error_count = 0;
+};
+
+} // namespace esp_expander
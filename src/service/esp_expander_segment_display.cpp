@@ -0,0 +1,308 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_expander_utils.h"
+#include "esp_expander_segment_display.hpp"
+
+#define TASK_STOP_WAIT_MS       (100)
+
+namespace esp_expander {
+
+SegmentDisplay::~SegmentDisplay()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool SegmentDisplay::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer == nullptr, false, "Already begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        !_config.segment_pins.empty() && !_config.digit_pins.empty(), false, "Segment and digit pins should be set"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(_config.refresh_hz > 0, false, "Invalid refresh rate");
+
+    uint32_t segment_mask = 0;
+    uint32_t digit_mask = 0;
+    for (auto pin : _config.segment_pins) {
+        ESP_UTILS_CHECK_FALSE_RETURN(pin < IO_COUNT_MAX, false, "Invalid pin(%d)", pin);
+        ESP_UTILS_CHECK_FALSE_RETURN(!(segment_mask & BIT(pin)), false, "Pin(%d) is used twice", pin);
+        segment_mask |= BIT(pin);
+    }
+    for (auto pin : _config.digit_pins) {
+        ESP_UTILS_CHECK_FALSE_RETURN(pin < IO_COUNT_MAX, false, "Invalid pin(%d)", pin);
+        ESP_UTILS_CHECK_FALSE_RETURN(!((segment_mask | digit_mask) & BIT(pin)), false, "Pin(%d) is used twice", pin);
+        digit_mask |= BIT(pin);
+    }
+
+    size_t row_num = _config.digit_pins.size();
+    _pin_mask = segment_mask | digit_mask;
+    _segment_off_levels = _config.segment_active_high ? 0 : segment_mask;
+    _blank_levels = _segment_off_levels | (_config.digit_active_high ? 0 : digit_mask);
+    _row_select_levels.resize(row_num);
+    for (size_t i = 0; i < row_num; i++) {
+        uint32_t digit = BIT(_config.digit_pins[i]);
+        _row_select_levels[i] = _config.digit_active_high ? digit : (digit_mask & ~digit);
+    }
+    _segments.assign(row_num, 0);
+    for (auto &row_levels : _row_levels) {
+        row_levels.resize(row_num);
+        for (size_t i = 0; i < row_num; i++) {
+            row_levels[i] = _row_select_levels[i] | _segment_off_levels;
+        }
+    }
+    _front = 0;
+    _swap_pending = false;
+    _row = 0;
+
+    // Start blank, so no segment flashes before the first refresh
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _expander.multiPinModeOutput(_pin_mask, _blank_levels), false, "Set pins output failed"
+    );
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = timerCallback,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "expander_display",
+        .skip_unhandled_events = true,
+    };
+    ESP_UTILS_CHECK_ERROR_GOTO(esp_timer_create(&timer_args, &_timer), err, "Create timer failed");
+
+    {
+        TaskHandle_t task_handle = nullptr;
+        _task_running = true;
+        BaseType_t ret = xTaskCreatePinnedToCore(
+                             taskEntry, "expander_display", _config.task_stack_size, this, _config.task_priority,
+                             &task_handle, (_config.task_core_id < 0) ? tskNO_AFFINITY : _config.task_core_id
+                         );
+        if (ret != pdPASS) {
+            _task_running = false;
+            ESP_UTILS_LOGE("Create refreshing task failed");
+            goto err;
+        }
+        _task_handle = task_handle;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+
+err:
+    if (_timer != nullptr) {
+        esp_timer_delete(_timer);
+        _timer = nullptr;
+    }
+
+    return false;
+}
+
+bool SegmentDisplay::del(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_is_started) {
+        ESP_UTILS_CHECK_FALSE_RETURN(stop(), false, "Stop failed");
+    }
+
+    if (_task_handle != nullptr) {
+        _task_running = false;
+        xTaskNotifyGive(_task_handle.load());
+        // The task clears its handle right before deleting itself
+        for (int i = 0; (_task_handle != nullptr) && (i < TASK_STOP_WAIT_MS); i++) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_task_handle == nullptr, false, "Wait for refreshing task exit timeout");
+    }
+
+    if (_timer != nullptr) {
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(_timer), false, "Delete timer failed");
+        _timer = nullptr;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool SegmentDisplay::start(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer != nullptr, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_started, false, "Already started");
+
+    uint64_t row_period_us = 1000000ULL / (static_cast<uint64_t>(_config.refresh_hz) * _config.digit_pins.size());
+    ESP_UTILS_CHECK_FALSE_RETURN(row_period_us > 0, false, "Refresh rate too high");
+
+    resetStats();
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_start_periodic(_timer, row_period_us), false, "Start timer failed");
+    _is_started = true;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool SegmentDisplay::stop(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_started, false, "Not started");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_stop(_timer), false, "Stop timer failed");
+    _is_started = false;
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_io_expander_write_output_stream(_expander.getDeviceHandle(), _pin_mask, &_blank_levels, 1), false,
+        "Turn off rows failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool SegmentDisplay::setRow(size_t row, uint32_t segments)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(row < _segments.size(), false, "Invalid row(%d)", static_cast<int>(row));
+
+    _segments[row] = segments;
+
+    return true;
+}
+
+bool SegmentDisplay::setChar(size_t digit, char c, bool dp)
+{
+    return setRow(digit, encodeChar(c) | (dp ? SEGMENT_DP : 0));
+}
+
+bool SegmentDisplay::print(const char *text)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(text, false, "Invalid text");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_segments.empty(), false, "Not begun");
+
+    SegmentEncoder::encodeText(text, _segments.data(), _segments.size());
+
+    return true;
+}
+
+void SegmentDisplay::clear(void)
+{
+    _segments.assign(_segments.size(), 0);
+}
+
+bool SegmentDisplay::show(void)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer != nullptr, false, "Not begun");
+
+    // Precompute the words out of the critical section
+    std::vector<uint32_t> row_levels(_segments.size());
+    for (size_t i = 0; i < row_levels.size(); i++) {
+        uint32_t on_levels = 0;
+        for (size_t j = 0; j < _config.segment_pins.size(); j++) {
+            if (_segments[i] & BIT(j)) {
+                on_levels |= BIT(_config.segment_pins[j]);
+            }
+        }
+        row_levels[i] = _row_select_levels[i] | (_segment_off_levels ^ on_levels);
+    }
+
+    // The back buffer is never read by the refresher until the swap, which is done at the start of a frame
+    portENTER_CRITICAL(&_lock);
+    _row_levels[_front ^ 1].swap(row_levels);
+    _swap_pending = true;
+    portEXIT_CRITICAL(&_lock);
+
+    return true;
+}
+
+SegmentDisplay::Stats SegmentDisplay::getStats(void) const
+{
+    return {
+        .frame_count = _frame_count,
+        .missed_count = _missed_count,
+        .error_count = _error_count,
+        .write_time_max_us = _write_time_max_us,
+    };
+}
+
+void SegmentDisplay::resetStats(void)
+{
+    _frame_count = 0;
+    _missed_count = 0;
+    _error_count = 0;
+    _write_time_max_us = 0;
+}
+
+void SegmentDisplay::timerCallback(void *arg)
+{
+    SegmentDisplay *display = static_cast<SegmentDisplay *>(arg);
+
+    xTaskNotifyGive(display->_task_handle.load());
+}
+
+void SegmentDisplay::taskEntry(void *arg)
+{
+    SegmentDisplay *display = static_cast<SegmentDisplay *>(arg);
+
+    ESP_UTILS_LOGD("Refreshing task start");
+
+    while (true) {
+        uint32_t notify_count = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!display->_task_running) {
+            break;
+        }
+        // More than one notification means the previous write took longer than the row period
+        if (notify_count > 1) {
+            display->_missed_count += notify_count - 1;
+        }
+        display->refreshRow();
+    }
+
+    ESP_UTILS_LOGD("Refreshing task exit");
+
+    display->_task_handle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void SegmentDisplay::refreshRow(void)
+{
+    if (_row == 0) {
+        portENTER_CRITICAL(&_lock);
+        if (_swap_pending) {
+            _front ^= 1;
+            _swap_pending = false;
+        }
+        portEXIT_CRITICAL(&_lock);
+    }
+
+    const uint32_t levels[] = {_blank_levels, _row_levels[_front][_row]};
+    const uint32_t *write_levels = _config.blank_between_rows ? levels : &levels[1];
+    size_t write_count = _config.blank_between_rows ? 2 : 1;
+
+    int64_t start_us = esp_timer_get_time();
+    if (esp_io_expander_write_output_stream(_expander.getDeviceHandle(), _pin_mask, write_levels, write_count) !=
+            ESP_OK) {
+        _error_count++;
+    }
+    uint32_t write_time_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    if (write_time_us > _write_time_max_us) {
+        _write_time_max_us = write_time_us;
+    }
+
+    if (++_row >= _row_select_levels.size()) {
+        _row = 0;
+        _frame_count++;
+    }
+}
+
+} // namespace esp_expander
@@ -0,0 +1,216 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "chip/esp_expander_base.hpp"
+#include "utils/esp_expander_segment_encoder.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The refresh driver of multiplexed LED displays, such as 7-segment digits and LED matrices
+ *
+ * @note  Each row (digit) is precomputed into an output word of all segment and digit pins, so the refresh of a row
+ *        takes a single register write. The rows are refreshed one after another by a dedicated task, triggered by an
+ *        `esp_timer`.
+ * @note  The frame is double buffered: drawing functions change the back buffer, and `show()` hands it to the
+ *        refresher, which switches at the start of the next frame, so a frame is never shown half drawn.
+ */
+class SegmentDisplay {
+public:
+    /**
+     * Bits of the 7-segment patterns, used by `encodeChar()`
+     */
+    constexpr static uint8_t SEGMENT_A = SegmentEncoder::SEGMENT_A;
+    constexpr static uint8_t SEGMENT_B = SegmentEncoder::SEGMENT_B;
+    constexpr static uint8_t SEGMENT_C = SegmentEncoder::SEGMENT_C;
+    constexpr static uint8_t SEGMENT_D = SegmentEncoder::SEGMENT_D;
+    constexpr static uint8_t SEGMENT_E = SegmentEncoder::SEGMENT_E;
+    constexpr static uint8_t SEGMENT_F = SegmentEncoder::SEGMENT_F;
+    constexpr static uint8_t SEGMENT_G = SegmentEncoder::SEGMENT_G;
+    constexpr static uint8_t SEGMENT_DP = SegmentEncoder::SEGMENT_DP;
+
+    /**
+     * @brief Configuration for SegmentDisplay object
+     */
+    struct Config {
+        std::vector<uint8_t> segment_pins;  /*!< Segment (column) pins (0-31), in the order of the bits of a row, for
+                                                 7-segment digits: A, B, C, D, E, F, G, DP */
+        std::vector<uint8_t> digit_pins;    /*!< Digit (row) common pins (0-31), one per row, from left to right */
+        bool segment_active_high = true;    /*!< Segments are on when their pins are high */
+        bool digit_active_high = false;     /*!< Rows are selected when their pins are high, false for common cathode
+                                                 digits driven directly */
+        uint32_t refresh_hz = 200;          /*!< Number of frames per second, each row is refreshed at this rate */
+        bool blank_between_rows = false;    /*!< Turn off all rows before selecting the next one to avoid ghosting, it
+                                                 doubles the writes if the chip doesn't support output streaming */
+        int task_priority = 22;             /*!< Priority of the refreshing task */
+        int task_stack_size = 3072;         /*!< Stack size of the refreshing task */
+        int task_core_id = -1;              /*!< Core of the refreshing task, -1 means no affinity */
+    };
+
+    /**
+     * @brief Refresh statistics
+     */
+    struct Stats {
+        uint32_t frame_count;               /*!< Number of refreshed frames */
+        uint32_t missed_count;              /*!< Number of row deadlines missed because the previous write is not done */
+        uint32_t error_count;               /*!< Number of failed writes */
+        uint32_t write_time_max_us;         /*!< Maximum time of a row write */
+    };
+
+    /**
+     * @brief Construct a display object
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object which the display is connected to
+     * @param[in] config   Configuration for the object
+     */
+    SegmentDisplay(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Destruct object. This function will call `del()` to delete the object.
+     */
+    ~SegmentDisplay();
+
+    /**
+     * @brief Set the pins to output mode with all rows off, and create the timer and the refreshing task
+     *
+     * @note  The refresh doesn't start until `start()` is called.
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void);
+
+    /**
+     * @brief Stop the refresh and release the resources
+     *
+     * @return true if success, otherwise false
+     */
+    bool del(void);
+
+    /**
+     * @brief Start the refresh, the statistics will be reset
+     *
+     * @return true if success, otherwise false
+     */
+    bool start(void);
+
+    /**
+     * @brief Stop the refresh and turn off all rows
+     *
+     * @return true if success, otherwise false
+     */
+    bool stop(void);
+
+    /**
+     * @brief Set the segments of a row in the back buffer
+     *
+     * @param[in] row      Index of the row in `Config::digit_pins`
+     * @param[in] segments Segments to turn on, bit `n` is `Config::segment_pins[n]`
+     *
+     * @return true if success, otherwise false
+     */
+    bool setRow(size_t row, uint32_t segments);
+
+    /**
+     * @brief Set a character of a 7-segment digit in the back buffer
+     *
+     * @param[in] digit Index of the digit in `Config::digit_pins`
+     * @param[in] c     Character, see `encodeChar()`
+     * @param[in] dp    Turn on the decimal point
+     *
+     * @return true if success, otherwise false
+     */
+    bool setChar(size_t digit, char c, bool dp = false);
+
+    /**
+     * @brief Set the characters of the 7-segment digits in the back buffer from the left, the remaining digits are
+     *        cleared
+     *
+     * @note  A '.' is merged into the decimal point of the previous character, e.g. "12.34" takes 4 digits.
+     *
+     * @param[in] text String
+     *
+     * @return true if success, otherwise false
+     */
+    bool print(const char *text);
+
+    /**
+     * @brief Turn off all segments in the back buffer
+     */
+    void clear(void);
+
+    /**
+     * @brief Hand the back buffer to the refresher, which shows it from the next frame
+     *
+     * @note  The back buffer keeps its content, so it can be changed incrementally.
+     *
+     * @return true if success, otherwise false
+     */
+    bool show(void);
+
+    /**
+     * @brief Get the refresh statistics
+     *
+     * @return Statistics
+     */
+    Stats getStats(void) const;
+
+    /**
+     * @brief Reset the refresh statistics
+     */
+    void resetStats(void);
+
+    /**
+     * @brief Encode a character into a 7-segment pattern, same as `SegmentEncoder::encodeChar()`
+     *
+     * @param[in] c Character
+     *
+     * @return Bitwise OR of `SEGMENT_*`, 0 if the character can't be shown
+     */
+    static uint8_t encodeChar(char c)
+    {
+        return SegmentEncoder::encodeChar(c);
+    }
+
+private:
+    static void timerCallback(void *arg);
+    static void taskEntry(void *arg);
+    void refreshRow(void);
+
+    Base &_expander;
+    Config _config;
+    uint32_t _pin_mask = 0;
+    uint32_t _segment_off_levels = 0;       // Levels of the segment pins with all segments off
+    uint32_t _blank_levels = 0;             // Levels of all pins with all rows off
+    std::vector<uint32_t> _row_select_levels; // Levels of the digit pins to select each row
+    std::vector<uint32_t> _segments;        // Back buffer of the segments
+    std::vector<uint32_t> _row_levels[2];   // Precomputed output words of each row, indexed by the buffer
+    uint8_t _front = 0;                     // Index of the buffer being refreshed
+    bool _swap_pending = false;
+    portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+    esp_timer_handle_t _timer = nullptr;
+    std::atomic<TaskHandle_t> _task_handle{nullptr};
+    std::atomic<bool> _task_running{false};
+    bool _is_started = false;
+
+    // Only accessed by the refreshing task
+    size_t _row = 0;
+
+    uint32_t _frame_count = 0;
+    uint32_t _missed_count = 0;
+    uint32_t _error_count = 0;
+    uint32_t _write_time_max_us = 0;
+};
+
+} // namespace esp_expander
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_expander_utils.h"
+#include "esp_expander_shift_register.hpp"
+
+namespace esp_expander {
+
+bool ShiftRegister::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+
+    const uint8_t pins[] = {
+        _config.clock_pin, _config.data_out_pin, _config.latch_pin, _config.data_in_pin, _config.load_pin
+    };
+    uint32_t used_pin_mask = 0;
+    for (auto pin : pins) {
+        if (!isPinUsed(pin)) {
+            continue;
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(pin < IO_COUNT_MAX, false, "Invalid pin(%d)", pin);
+        ESP_UTILS_CHECK_FALSE_RETURN(!(used_pin_mask & BIT(pin)), false, "Pin(%d) is used twice", pin);
+        used_pin_mask |= BIT(pin);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(isPinUsed(_config.clock_pin), false, "Clock pin should be used");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        isPinUsed(_config.data_out_pin) || isPinUsed(_config.data_in_pin), false, "No data pin"
+    );
+
+    uint32_t clock = getPinBit(_config.clock_pin);
+    uint32_t data_out = getPinBit(_config.data_out_pin);
+    uint32_t load = getPinBit(_config.load_pin);
+    _out_pin_mask = clock | data_out | getPinBit(_config.latch_pin) | load;
+    _idle_levels = load;
+    _bit_levels[0][0] = _idle_levels;
+    _bit_levels[0][1] = _idle_levels | clock;
+    _bit_levels[1][0] = _idle_levels | data_out;
+    _bit_levels[1][1] = _idle_levels | data_out | clock;
+
+    // The load pin starts high, so the 74HC165 chain isn't loading meanwhile
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _expander.multiPinModeOutput(_out_pin_mask, _idle_levels), false, "Set pins output failed"
+    );
+    if (isPinUsed(_config.data_in_pin)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(_expander.pinMode(_config.data_in_pin, INPUT), false, "Set pin input failed");
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool ShiftRegister::shiftOut(const uint8_t *data, size_t len)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_out_pin_mask != 0, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(isPinUsed(_config.data_out_pin), false, "Data output pin is not used");
+    ESP_UTILS_CHECK_FALSE_RETURN((data != nullptr) && (len > 0), false, "Invalid data");
+
+    // 2 levels per bit, then clock low, and a latch pulse if used
+    bool msb_first = (_config.bit_order == BitOrder::MSB_FIRST);
+    _levels.clear();
+    _levels.reserve(len * 16 + 3);
+    for (size_t i = 0; i < len; i++) {
+        for (int j = 0; j < 8; j++) {
+            int bit = (data[i] >> (msb_first ? (7 - j) : j)) & 1;
+            _levels.push_back(_bit_levels[bit][0]);
+            _levels.push_back(_bit_levels[bit][1]);
+        }
+    }
+    _levels.push_back(_idle_levels);
+    if (isPinUsed(_config.latch_pin)) {
+        _levels.push_back(_idle_levels | BIT(_config.latch_pin));
+        _levels.push_back(_idle_levels);
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _expander.multiDigitalWriteStream(_out_pin_mask, _levels.data(), _levels.size()), false, "Shift out failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool ShiftRegister::shiftIn(uint8_t *data, size_t len)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_out_pin_mask != 0, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(isPinUsed(_config.data_in_pin), false, "Data input pin is not used");
+    ESP_UTILS_CHECK_FALSE_RETURN((data != nullptr) && (len > 0), false, "Invalid data");
+
+    esp_io_expander_handle_t handle = _expander.getDeviceHandle();
+    uint32_t clock = BIT(_config.clock_pin);
+    uint32_t data_in = BIT(_config.data_in_pin);
+    uint32_t level = 0;
+
+    // Load the parallel inputs, the first bit is ready as soon as the load pin is released
+    if (isPinUsed(_config.load_pin)) {
+        const uint32_t load_levels[] = {_idle_levels & ~getPinBit(_config.load_pin), _idle_levels};
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _expander.multiDigitalWriteStream(_out_pin_mask, load_levels, 2), false, "Load failed"
+        );
+    }
+
+    // Each bit is read together with the clock low write, then the clock high write shifts the next bit
+    bool msb_first = (_config.bit_order == BitOrder::MSB_FIRST);
+    for (size_t i = 0; i < len; i++) {
+        uint8_t value = 0;
+        for (int j = 0; j < 8; j++) {
+            ESP_UTILS_CHECK_ERROR_RETURN(
+                esp_io_expander_exchange_level(handle, clock, 0, data_in, &level), false, "Read bit failed"
+            );
+            if (level) {
+                value |= BIT(msb_first ? (7 - j) : j);
+            }
+            // The clock is left low after the last bit
+            if ((i < len - 1) || (j < 7)) {
+                ESP_UTILS_CHECK_ERROR_RETURN(
+                    esp_io_expander_write_output_stream(handle, clock, &clock, 1), false, "Write clock failed"
+                );
+            }
+        }
+        data[i] = value;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+} // namespace esp_expander
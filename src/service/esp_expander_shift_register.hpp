@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <vector>
+#include "chip/esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The shift register engine over IO expander pins, such as 74HC595 (output) and 74HC165 (input) chains
+ *
+ * @note  `shiftOut()` compiles the clock/data/latch edges of the whole chain into a sequence of output levels, which is
+ *        sent by `Base::multiDigitalWriteStream()`. So the chips supporting output streaming (e.g. TCA9554, HT8574)
+ *        shift a whole chain in a few transactions instead of one read-modify-write per edge.
+ * @note  `shiftIn()` writes each clock edge together with the input read in a single transaction if the chip supports
+ *        it (see `esp_io_expander_exchange_level()`), so each bit takes 2 transactions.
+ * @note  Data is shifted on the rising edge of the clock, which idles low.
+ */
+class ShiftRegister {
+public:
+    constexpr static uint8_t PIN_NONE = 0xFF;
+
+    /**
+     * @brief Order of the bits in each byte
+     */
+    enum class BitOrder {
+        MSB_FIRST,
+        LSB_FIRST,
+    };
+
+    /**
+     * @brief Configuration for ShiftRegister object
+     */
+    struct Config {
+        uint8_t clock_pin;                  /*!< Clock pin (0-31), e.g. SRCLK of 74HC595 and CLK of 74HC165 */
+        uint8_t data_out_pin = PIN_NONE;    /*!< Serial output pin (0-31), e.g. SER of 74HC595, `PIN_NONE` if unused */
+        uint8_t latch_pin = PIN_NONE;       /*!< Latch pin (0-31), pulsed high after shifting out, e.g. RCLK of
+                                                 74HC595, `PIN_NONE` if unused */
+        uint8_t data_in_pin = PIN_NONE;     /*!< Serial input pin (0-31), e.g. QH of 74HC165, `PIN_NONE` if unused */
+        uint8_t load_pin = PIN_NONE;        /*!< Load pin (0-31), pulsed low before shifting in, e.g. SH/LD of
+                                                 74HC165, `PIN_NONE` if unused */
+        BitOrder bit_order = BitOrder::MSB_FIRST; /*!< Order of the bits in each byte */
+    };
+
+    /**
+     * @brief Construct a shift register engine
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object which the pins belong to
+     * @param[in] config   Configuration for the object
+     */
+    ShiftRegister(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Set the pins to their modes and idle levels (clock, data and latch low, load high), and precompute the
+     *        levels of each bit
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void);
+
+    /**
+     * @brief Shift out the bytes and then pulse the latch pin if it is used
+     *
+     * @note  For a daisy chain, the byte of the last register in the chain should be sent first.
+     *
+     * @param[in] data Bytes to shift out
+     * @param[in] len  Number of bytes
+     *
+     * @return true if success, otherwise false
+     */
+    bool shiftOut(const uint8_t *data, size_t len);
+
+    /**
+     * @brief Pulse the load pin if it is used and then shift in the bytes
+     *
+     * @note  For a daisy chain, the first byte is from the last register in the chain.
+     *
+     * @param[out] data Bytes shifted in
+     * @param[in]  len  Number of bytes
+     *
+     * @return true if success, otherwise false
+     */
+    bool shiftIn(uint8_t *data, size_t len);
+
+private:
+    bool isPinUsed(uint8_t pin) const
+    {
+        return pin != PIN_NONE;
+    }
+
+    uint32_t getPinBit(uint8_t pin) const
+    {
+        return isPinUsed(pin) ? BIT(pin) : 0;
+    }
+
+    Base &_expander;
+    Config _config;
+    uint32_t _out_pin_mask = 0;
+    uint32_t _idle_levels = 0;
+    uint32_t _bit_levels[2][2] = {};        // [Data bit][Clock level], from the idle levels
+    std::vector<uint32_t> _levels;          // Reused for each transfer
+};
+
+} // namespace esp_expander
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_expander_utils.h"
+#include "esp_expander_spi_3wire.hpp"
+
+namespace esp_expander {
+
+bool SPI3Wire::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_config.cs_pin < IO_COUNT_MAX) && (_config.scl_pin < IO_COUNT_MAX) && (_config.sda_pin < IO_COUNT_MAX),
+        false, "Invalid pins"
+    );
+
+    uint32_t cs = BIT(_config.cs_pin);
+    uint32_t scl = BIT(_config.scl_pin);
+    uint32_t sda = BIT(_config.sda_pin);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (cs != scl) && (cs != sda) && (scl != sda), false, "Pins should be different"
+    );
+    _pin_mask = cs | scl | sda;
+    _idle_levels = cs;
+    _bit_levels[0][0] = 0;
+    _bit_levels[0][1] = scl;
+    _bit_levels[1][0] = sda;
+    _bit_levels[1][1] = sda | scl;
+
+    // CS starts high, so the device never sees a false select
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _expander.multiPinModeOutput(_pin_mask, _idle_levels), false, "Set pins output failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool SPI3Wire::writeCommand(uint8_t cmd, const uint8_t *params, size_t param_bytes)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_pin_mask != 0, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN((params != nullptr) || (param_bytes == 0), false, "Invalid params");
+
+    // CS low, 2 levels per bit, then SCK low and CS high
+    size_t bits_per_byte = _config.use_dc_bit ? 9 : 8;
+    _levels.clear();
+    _levels.reserve((1 + param_bytes) * bits_per_byte * 2 + 3);
+    _levels.push_back(_bit_levels[0][0]);
+    appendByte(cmd, false);
+    for (size_t i = 0; i < param_bytes; i++) {
+        appendByte(params[i], true);
+    }
+    _levels.push_back(_bit_levels[0][0]);
+    _levels.push_back(_idle_levels);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _expander.multiDigitalWriteStream(_pin_mask, _levels.data(), _levels.size()), false,
+        "Write command(0x%02x) failed", cmd
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool SPI3Wire::writeInitSequence(const InitCmd *cmds, size_t cmd_num)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_NULL_RETURN(cmds, false, "Invalid commands");
+
+    for (size_t i = 0; i < cmd_num; i++) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            writeCommand(cmds[i].cmd, cmds[i].data, cmds[i].data_bytes), false, "Write command[%d] failed",
+            static_cast<int>(i)
+        );
+        if (cmds[i].delay_ms > 0) {
+            vTaskDelay(pdMS_TO_TICKS(cmds[i].delay_ms));
+        }
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+void SPI3Wire::appendByte(uint8_t value, bool is_data)
+{
+    if (_config.use_dc_bit) {
+        _levels.push_back(_bit_levels[is_data][0]);
+        _levels.push_back(_bit_levels[is_data][1]);
+    }
+    for (int bit = 7; bit >= 0; bit--) {
+        int sda = (value >> bit) & 1;
+        _levels.push_back(_bit_levels[sda][0]);
+        _levels.push_back(_bit_levels[sda][1]);
+    }
+}
+
+} // namespace esp_expander
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <vector>
+#include "chip/esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The 3-wire SPI serializer over IO expander pins, typically used to initialize RGB LCD panels
+ *
+ * @note  Each transfer is turned into a sequence of CS/SCK/SDA output levels, which is sent by
+ *        `Base::multiDigitalWriteStream()`. So the chips supporting output streaming (e.g. TCA9554, HT8574) send a
+ *        whole command in a few transactions instead of several read-modify-write calls per clock edge.
+ * @note  SPI mode 0 (SCK idle low, sampled on the rising edge), MSB first.
+ */
+class SPI3Wire {
+public:
+    /**
+     * @brief Configuration for SPI3Wire object
+     */
+    struct Config {
+        uint8_t cs_pin;                     /*!< CS pin (0-31), active low */
+        uint8_t scl_pin;                    /*!< SCK pin (0-31) */
+        uint8_t sda_pin;                    /*!< SDA pin (0-31) */
+        bool use_dc_bit = true;             /*!< Send a D/C bit (0: command, 1: data) before each byte (9-bit mode) */
+    };
+
+    /**
+     * @brief Command of an initialization sequence
+     */
+    struct InitCmd {
+        uint8_t cmd;                        /*!< Command */
+        const uint8_t *data;                /*!< Parameters of the command */
+        size_t data_bytes;                  /*!< Number of parameters */
+        uint32_t delay_ms;                  /*!< Delay after the command */
+    };
+
+    /**
+     * @brief Construct a 3-wire SPI serializer
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object which the pins belong to
+     * @param[in] config   Configuration for the object
+     */
+    SPI3Wire(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Set the pins to output mode and idle levels (CS high, SCK low), and precompute the levels of each bit
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void);
+
+    /**
+     * @brief Send a command and its parameters in a single CS-low period
+     *
+     * @param[in] cmd         Command
+     * @param[in] params      Parameters, can be nullptr if `param_bytes` is 0
+     * @param[in] param_bytes Number of parameters
+     *
+     * @return true if success, otherwise false
+     */
+    bool writeCommand(uint8_t cmd, const uint8_t *params = nullptr, size_t param_bytes = 0);
+
+    /**
+     * @brief Send a sequence of commands, such as the initialization sequence of a LCD panel
+     *
+     * @param[in] cmds     Commands
+     * @param[in] cmd_num  Number of commands
+     *
+     * @return true if success, otherwise false
+     */
+    bool writeInitSequence(const InitCmd *cmds, size_t cmd_num);
+
+private:
+    void appendByte(uint8_t value, bool is_data);
+
+    Base &_expander;
+    Config _config;
+    uint32_t _pin_mask = 0;
+    uint32_t _idle_levels = 0;
+    uint32_t _bit_levels[2][2] = {};        // [SDA bit][SCK level], with CS low
+    std::vector<uint32_t> _levels;          // Reused for each transfer
+};
+
+} // namespace esp_expander
@@ -0,0 +1,322 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_expander_utils.h"
+#include "esp_expander_stepper.hpp"
+
+#define TASK_STOP_WAIT_MS       (100)
+
+namespace esp_expander {
+
+namespace {
+
+// Coils of each phase, bit `n` is the pin `n` of `MotorConfig::pins`
+const uint8_t WAVE_PHASES[] = {0x1, 0x2, 0x4, 0x8};
+const uint8_t FULL_STEP_PHASES[] = {0x3, 0x6, 0xC, 0x9};
+const uint8_t HALF_STEP_PHASES[] = {0x1, 0x3, 0x2, 0x6, 0x4, 0xC, 0x8, 0x9};
+
+} // namespace
+
+Stepper::~Stepper()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool Stepper::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer == nullptr, false, "Already begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_config.motors.empty(), false, "No motor");
+    ESP_UTILS_CHECK_FALSE_RETURN(_config.tick_hz > 0, false, "Invalid tick rate");
+
+    uint32_t pin_mask = 0;
+    _motors.clear();
+    for (const auto &motor_config : _config.motors) {
+        Motor motor = {};
+        for (auto pin : motor_config.pins) {
+            ESP_UTILS_CHECK_FALSE_RETURN(pin < IO_COUNT_MAX, false, "Invalid pin(%d)", pin);
+            ESP_UTILS_CHECK_FALSE_RETURN(!(pin_mask & BIT(pin)), false, "Pin(%d) is used twice", pin);
+            pin_mask |= BIT(pin);
+            motor.pin_mask |= BIT(pin);
+        }
+
+        const uint8_t *phases = nullptr;
+        switch (motor_config.mode) {
+        case StepMode::WAVE:
+            phases = WAVE_PHASES;
+            motor.phase_num = sizeof(WAVE_PHASES);
+            break;
+        case StepMode::FULL_STEP:
+            phases = FULL_STEP_PHASES;
+            motor.phase_num = sizeof(FULL_STEP_PHASES);
+            break;
+        case StepMode::HALF_STEP:
+            phases = HALF_STEP_PHASES;
+            motor.phase_num = sizeof(HALF_STEP_PHASES);
+            break;
+        default:
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Invalid step mode");
+        }
+        for (int i = 0; i < motor.phase_num; i++) {
+            motor.phase_levels[i] = 0;
+            for (int j = 0; j < 4; j++) {
+                if (phases[i] & BIT(j)) {
+                    motor.phase_levels[i] |= BIT(motor_config.pins[j]);
+                }
+            }
+        }
+        _motors.push_back(motor);
+    }
+    _pin_mask = pin_mask;
+    _levels_changed = false;
+    resetStats();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiPinModeOutput(_pin_mask, 0), false, "Set pins output failed");
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = timerCallback,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "expander_stepper",
+        .skip_unhandled_events = true,
+    };
+    ESP_UTILS_CHECK_ERROR_GOTO(esp_timer_create(&timer_args, &_timer), err, "Create timer failed");
+
+    {
+        TaskHandle_t task_handle = nullptr;
+        _task_running = true;
+        BaseType_t ret = xTaskCreatePinnedToCore(
+                             taskEntry, "expander_stepper", _config.task_stack_size, this, _config.task_priority,
+                             &task_handle, (_config.task_core_id < 0) ? tskNO_AFFINITY : _config.task_core_id
+                         );
+        if (ret != pdPASS) {
+            _task_running = false;
+            ESP_UTILS_LOGE("Create stepping task failed");
+            goto err;
+        }
+        _task_handle = task_handle;
+    }
+    ESP_UTILS_CHECK_ERROR_GOTO(esp_timer_start_periodic(_timer, 1000000 / _config.tick_hz), err, "Start timer failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+
+err:
+    ESP_UTILS_CHECK_FALSE_RETURN(del(), false, "Delete failed");
+
+    return false;
+}
+
+bool Stepper::del(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_timer != nullptr) {
+        esp_timer_stop(_timer);
+    }
+
+    if (_task_handle != nullptr) {
+        _task_running = false;
+        xTaskNotifyGive(_task_handle.load());
+        // The task clears its handle right before deleting itself
+        for (int i = 0; (_task_handle != nullptr) && (i < TASK_STOP_WAIT_MS); i++) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_task_handle == nullptr, false, "Wait for stepping task exit timeout");
+    }
+
+    if (_timer != nullptr) {
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(_timer), false, "Delete timer failed");
+        _timer = nullptr;
+        // Release the coils
+        ESP_UTILS_CHECK_FALSE_RETURN(_expander.multiDigitalWrite(_pin_mask, LOW), false, "Set pins low failed");
+    }
+    _motors.clear();
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Stepper::move(size_t motor, int32_t steps, float speed_sps, float accel_sps2)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer != nullptr, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(motor < _motors.size(), false, "Invalid motor(%d)", static_cast<int>(motor));
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (speed_sps > 0) && (speed_sps <= _config.tick_hz), false, "Invalid speed(%.1f), should be in (0, %d]",
+        speed_sps, static_cast<int>(_config.tick_hz)
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(accel_sps2 >= 0, false, "Invalid acceleration(%.1f)", accel_sps2);
+
+    float tick_hz = static_cast<float>(_config.tick_hz);
+    portENTER_CRITICAL(&_lock);
+    Motor &m = _motors[motor];
+    m.steps_left = (steps < 0) ? -static_cast<int64_t>(steps) : steps;
+    m.direction = (steps < 0) ? -1 : 1;
+    m.max_speed = speed_sps / tick_hz;
+    m.accel = accel_sps2 / (tick_hz * tick_hz);
+    m.speed = (m.accel > 0) ? 0 : m.max_speed;
+    m.step_progress = 0;
+    if (!m.is_energized) {
+        m.is_energized = true;
+        _levels_changed = true;
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Stepper::stop(size_t motor, bool release)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_timer != nullptr, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(motor < _motors.size(), false, "Invalid motor(%d)", static_cast<int>(motor));
+
+    portENTER_CRITICAL(&_lock);
+    Motor &m = _motors[motor];
+    m.steps_left = 0;
+    m.speed = 0;
+    if (release && m.is_energized) {
+        m.is_energized = false;
+        _levels_changed = true;
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    return true;
+}
+
+bool Stepper::isRunning(size_t motor) const
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(motor < _motors.size(), false, "Invalid motor(%d)", static_cast<int>(motor));
+
+    return _motors[motor].steps_left > 0;
+}
+
+int32_t Stepper::getPosition(size_t motor) const
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(motor < _motors.size(), 0, "Invalid motor(%d)", static_cast<int>(motor));
+
+    return _motors[motor].position;
+}
+
+Stepper::Stats Stepper::getStats(void) const
+{
+    return {
+        .tick_count = _tick_count,
+        .write_count = _write_count,
+        .missed_count = _missed_count,
+        .error_count = _error_count,
+    };
+}
+
+void Stepper::resetStats(void)
+{
+    _tick_count = 0;
+    _write_count = 0;
+    _missed_count = 0;
+    _error_count = 0;
+}
+
+void Stepper::timerCallback(void *arg)
+{
+    Stepper *stepper = static_cast<Stepper *>(arg);
+
+    xTaskNotifyGive(stepper->_task_handle.load());
+}
+
+void Stepper::taskEntry(void *arg)
+{
+    Stepper *stepper = static_cast<Stepper *>(arg);
+
+    ESP_UTILS_LOGD("Stepping task start");
+
+    while (true) {
+        uint32_t notify_count = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!stepper->_task_running) {
+            break;
+        }
+        // Skipped ticks are not caught up, the motors would lose steps if several phases were jumped at once
+        if (notify_count > 1) {
+            stepper->_missed_count += notify_count - 1;
+        }
+        stepper->processTick();
+    }
+
+    ESP_UTILS_LOGD("Stepping task exit");
+
+    stepper->_task_handle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void Stepper::processTick(void)
+{
+    bool is_stepped = false;
+    uint32_t levels = 0;
+
+    portENTER_CRITICAL(&_lock);
+    for (auto &motor : _motors) {
+        is_stepped |= advanceMotor(motor);
+        levels |= getMotorLevels(motor);
+    }
+    portEXIT_CRITICAL(&_lock);
+    _tick_count++;
+
+    // All motors share a single write
+    if (_levels_changed.exchange(false) || is_stepped) {
+        _write_count++;
+        if (esp_io_expander_write_output_stream(_expander.getDeviceHandle(), _pin_mask, &levels, 1) != ESP_OK) {
+            _error_count++;
+        }
+    }
+}
+
+bool Stepper::advanceMotor(Motor &motor)
+{
+    if (motor.steps_left == 0) {
+        return false;
+    }
+
+    if (motor.accel > 0) {
+        // Decelerate when the remaining steps are just enough to stop
+        float stop_steps = motor.speed * motor.speed / (2 * motor.accel);
+        if (motor.steps_left <= stop_steps) {
+            motor.speed -= motor.accel;
+            if (motor.speed < motor.accel) {
+                motor.speed = motor.accel;
+            }
+        } else if (motor.speed < motor.max_speed) {
+            motor.speed += motor.accel;
+            if (motor.speed > motor.max_speed) {
+                motor.speed = motor.max_speed;
+            }
+        }
+    }
+
+    motor.step_progress += motor.speed;
+    if (motor.step_progress < 1) {
+        return false;
+    }
+    motor.step_progress -= 1;
+    motor.position += motor.direction;
+    if (--motor.steps_left == 0) {
+        motor.speed = 0;
+        motor.step_progress = 0;
+    }
+
+    return true;
+}
+
+} // namespace esp_expander
@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "chip/esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The sequencing engine of unipolar stepper motors (e.g. 28BYJ-48 with ULN2003) on IO expander outputs
+ *
+ * @note  The phase tables of each motor are precomputed into output words. Every tick of an `esp_timer`, a dedicated
+ *        task advances all motors and merges their phases into a single register write, which is skipped if no motor
+ *        steps in the tick.
+ * @note  The tick rate is the highest step rate. Each motor runs at its own rate with an optional trapezoidal
+ *        acceleration profile.
+ */
+class Stepper {
+public:
+    /**
+     * @brief Step mode, which selects the phase table
+     */
+    enum class StepMode {
+        WAVE,                               /*!< One coil on at a time, 4 steps per cycle */
+        FULL_STEP,                          /*!< Two coils on at a time, 4 steps per cycle, higher torque */
+        HALF_STEP,                          /*!< Alternate one and two coils on, 8 steps per cycle */
+    };
+
+    /**
+     * @brief Configuration of a motor
+     */
+    struct MotorConfig {
+        std::array<uint8_t, 4> pins;        /*!< Pins (0-31) of the coils, in the order of IN1-IN4 of ULN2003 */
+        StepMode mode = StepMode::HALF_STEP; /*!< Step mode */
+    };
+
+    /**
+     * @brief Configuration for Stepper object
+     */
+    struct Config {
+        std::vector<MotorConfig> motors;    /*!< Motors, all on the same expander */
+        uint32_t tick_hz = 1000;            /*!< Rate of the ticks, which is the highest step rate */
+        int task_priority = 20;             /*!< Priority of the stepping task */
+        int task_stack_size = 3072;         /*!< Stack size of the stepping task */
+        int task_core_id = -1;              /*!< Core of the stepping task, -1 means no affinity */
+    };
+
+    /**
+     * @brief Stepping statistics
+     */
+    struct Stats {
+        uint32_t tick_count;                /*!< Number of processed ticks */
+        uint32_t write_count;               /*!< Number of register writes, only the ticks with steps write */
+        uint32_t missed_count;              /*!< Number of ticks skipped because the previous write is not done */
+        uint32_t error_count;               /*!< Number of failed writes */
+    };
+
+    /**
+     * @brief Construct a stepper engine
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object which the motors are connected to
+     * @param[in] config   Configuration for the object
+     */
+    Stepper(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Destruct object. This function will call `del()` to delete the object.
+     */
+    ~Stepper();
+
+    /**
+     * @brief Set the pins to output low, precompute the phase words, and start the timer and the stepping task
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void);
+
+    /**
+     * @brief Stop all motors, release the coils and the resources
+     *
+     * @return true if success, otherwise false
+     */
+    bool del(void);
+
+    /**
+     * @brief Move a motor by a number of steps, the previous move of the motor is replaced
+     *
+     * @param[in] motor       Index of the motor in `Config::motors`
+     * @param[in] steps       Number of steps, negative for the reverse direction
+     * @param[in] speed_sps   Highest speed in steps per second, should be in (0, `Config::tick_hz`]
+     * @param[in] accel_sps2  Acceleration and deceleration in steps per second squared, 0 to run at full speed
+     *
+     * @return true if success, otherwise false
+     */
+    bool move(size_t motor, int32_t steps, float speed_sps, float accel_sps2 = 0);
+
+    /**
+     * @brief Stop a motor immediately
+     *
+     * @param[in] motor   Index of the motor in `Config::motors`
+     * @param[in] release Turn off the coils, otherwise they keep holding the position
+     *
+     * @return true if success, otherwise false
+     */
+    bool stop(size_t motor, bool release = false);
+
+    /**
+     * @brief Check if a motor is moving
+     *
+     * @param[in] motor Index of the motor in `Config::motors`
+     *
+     * @return true if moving, otherwise false
+     */
+    bool isRunning(size_t motor) const;
+
+    /**
+     * @brief Get the position of a motor, which is the sum of the executed steps
+     *
+     * @param[in] motor Index of the motor in `Config::motors`
+     *
+     * @return Position in steps, 0 if the motor is invalid
+     */
+    int32_t getPosition(size_t motor) const;
+
+    /**
+     * @brief Get the stepping statistics
+     *
+     * @return Statistics
+     */
+    Stats getStats(void) const;
+
+    /**
+     * @brief Reset the stepping statistics
+     */
+    void resetStats(void);
+
+private:
+    struct Motor {
+        std::array<uint32_t, 8> phase_levels; // Output words of the phases
+        uint32_t pin_mask;
+        uint8_t phase_num;
+        int32_t position;
+        uint32_t steps_left;
+        int8_t direction;
+        float max_speed;                    // Steps per tick
+        float accel;                        // Steps per tick squared
+        float speed;                        // Steps per tick
+        float step_progress;                // Fraction of the next step
+        bool is_energized;
+    };
+
+    static void timerCallback(void *arg);
+    static void taskEntry(void *arg);
+    void processTick(void);
+    bool advanceMotor(Motor &motor);
+    uint32_t getMotorLevels(const Motor &motor) const
+    {
+        return motor.is_energized ? motor.phase_levels[motor.position & (motor.phase_num - 1)] : 0;
+    }
+
+    Base &_expander;
+    Config _config;
+    uint32_t _pin_mask = 0;
+    std::vector<Motor> _motors;
+    portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+    esp_timer_handle_t _timer = nullptr;
+    std::atomic<TaskHandle_t> _task_handle{nullptr};
+    std::atomic<bool> _task_running{false};
+    std::atomic<bool> _levels_changed{false};
+
+    uint32_t _tick_count = 0;
+    uint32_t _write_count = 0;
+    uint32_t _missed_count = 0;
+    uint32_t _error_count = 0;
+};
+
+} // namespace esp_expander
@@ -0,0 +1,322 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include "esp_expander_utils.h"
+#include "esp_expander_timeline.hpp"
+
+#define TASK_STOP_WAIT_MS       (100)
+#define TIMER_DELAY_MIN_US      (20)
+#define MERGE_EVENTS_MAX        (32)
+
+namespace esp_expander {
+
+namespace {
+
+// Comparator of the min-heap: the earliest event is at the front
+struct EventLater {
+    template <typename T>
+    bool operator()(const T &a, const T &b) const
+    {
+        return (a.due_us != b.due_us) ? (a.due_us > b.due_us) : (static_cast<int32_t>(a.seq - b.seq) > 0);
+    }
+};
+
+} // namespace
+
+Timeline::~Timeline()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool Timeline::begin(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_mutex == nullptr, false, "Already begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_expander.isOverState(Base::State::BEGIN), false, "Expander not begun");
+
+    _mutex = xSemaphoreCreateMutex();
+    ESP_UTILS_CHECK_NULL_RETURN(_mutex, false, "Create mutex failed");
+    _events.clear();
+    resetStats();
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = timerCallback,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "expander_timeline",
+        .skip_unhandled_events = true,
+    };
+    ESP_UTILS_CHECK_ERROR_GOTO(esp_timer_create(&timer_args, &_timer), err, "Create timer failed");
+
+    {
+        TaskHandle_t task_handle = nullptr;
+        _task_running = true;
+        BaseType_t ret = xTaskCreatePinnedToCore(
+                             taskEntry, "expander_timeline", _config.task_stack_size, this, _config.task_priority,
+                             &task_handle, (_config.task_core_id < 0) ? tskNO_AFFINITY : _config.task_core_id
+                         );
+        if (ret != pdPASS) {
+            _task_running = false;
+            ESP_UTILS_LOGE("Create executing task failed");
+            goto err;
+        }
+        _task_handle = task_handle;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+
+err:
+    if (_timer != nullptr) {
+        esp_timer_delete(_timer);
+        _timer = nullptr;
+    }
+    vSemaphoreDelete(_mutex);
+    _mutex = nullptr;
+
+    return false;
+}
+
+bool Timeline::del(void)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_task_handle != nullptr) {
+        _task_running = false;
+        xTaskNotifyGive(_task_handle.load());
+        // The task clears its handle right before deleting itself
+        for (int i = 0; (_task_handle != nullptr) && (i < TASK_STOP_WAIT_MS); i++) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_task_handle == nullptr, false, "Wait for executing task exit timeout");
+    }
+
+    if (_timer != nullptr) {
+        esp_timer_stop(_timer);
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(_timer), false, "Delete timer failed");
+        _timer = nullptr;
+    }
+    if (_mutex != nullptr) {
+        vSemaphoreDelete(_mutex);
+        _mutex = nullptr;
+    }
+    _events.clear();
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Timeline::submit(const std::vector<Step> &steps, int *timeline_id)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_mutex != nullptr, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!steps.empty(), false, "Steps should not be empty");
+
+    int64_t now_us = esp_timer_get_time();
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    int id = _next_timeline_id++;
+    if (_next_timeline_id < 0) {
+        _next_timeline_id = 0;
+    }
+    for (size_t i = 0; i < steps.size(); i++) {
+        _events.push_back({
+            .due_us = now_us + steps[i].offset_us,
+            .seq = _next_seq++,
+            .pin_mask = steps[i].pin_mask,
+            .levels = steps[i].levels,
+            .timeline_id = id,
+            .step_index = i,
+        });
+        std::push_heap(_events.begin(), _events.end(), EventLater());
+    }
+    xSemaphoreGive(_mutex);
+
+    // Let the task rearm the timer if the new steps are earlier
+    xTaskNotifyGive(_task_handle.load());
+    if (timeline_id != nullptr) {
+        *timeline_id = id;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Timeline::pulse(uint32_t pin_mask, uint8_t level, uint32_t width_us, uint32_t delay_us, int *timeline_id)
+{
+    uint32_t active_levels = level ? pin_mask : 0;
+
+    return submit({
+        {delay_us, pin_mask, active_levels},
+        {delay_us + width_us, pin_mask, ~active_levels & pin_mask},
+    }, timeline_id);
+}
+
+bool Timeline::cancel(int timeline_id)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_mutex != nullptr, false, "Not begun");
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    size_t old_size = _events.size();
+    _events.erase(std::remove_if(_events.begin(), _events.end(), [timeline_id](const Event & event) {
+        return event.timeline_id == timeline_id;
+    }), _events.end());
+    bool found = (_events.size() != old_size);
+    if (found) {
+        std::make_heap(_events.begin(), _events.end(), EventLater());
+    }
+    xSemaphoreGive(_mutex);
+
+    if (!found) {
+        ESP_UTILS_LOGD("No pending step of timeline(%d)", timeline_id);
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return found;
+}
+
+size_t Timeline::getPendingSteps(void) const
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_mutex != nullptr, 0, "Not begun");
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    size_t count = _events.size();
+    xSemaphoreGive(_mutex);
+
+    return count;
+}
+
+Timeline::Stats Timeline::getStats(void) const
+{
+    Stats stats = {
+        .step_count = _step_count,
+        .write_count = _write_count,
+        .error_count = _error_count,
+        .timing_error_avg_us = 0,
+        .timing_error_max_us = _timing_error_max_us,
+    };
+    if (_step_count > 0) {
+        stats.timing_error_avg_us = static_cast<uint32_t>(_timing_error_total_us / _step_count);
+    }
+
+    return stats;
+}
+
+void Timeline::resetStats(void)
+{
+    _step_count = 0;
+    _write_count = 0;
+    _error_count = 0;
+    _timing_error_total_us = 0;
+    _timing_error_max_us = 0;
+}
+
+void Timeline::timerCallback(void *arg)
+{
+    Timeline *timeline = static_cast<Timeline *>(arg);
+
+    xTaskNotifyGive(timeline->_task_handle.load());
+}
+
+void Timeline::taskEntry(void *arg)
+{
+    Timeline *timeline = static_cast<Timeline *>(arg);
+
+    ESP_UTILS_LOGD("Executing task start");
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!timeline->_task_running) {
+            break;
+        }
+        timeline->executeDueEvents();
+    }
+
+    ESP_UTILS_LOGD("Executing task exit");
+
+    timeline->_task_handle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void Timeline::executeDueEvents(void)
+{
+    Event batch[MERGE_EVENTS_MAX];
+
+    while (true) {
+        size_t batch_size = 0;
+        uint32_t pin_mask = 0;
+        uint32_t levels = 0;
+        int64_t next_due_us = -1;
+
+        // Merge the due events, until one touches a pin already set by the batch, so no change of a pin is lost
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        int64_t deadline_us = esp_timer_get_time() + _config.merge_window_us;
+        while (!_events.empty() && (batch_size < MERGE_EVENTS_MAX)) {
+            const Event &event = _events.front();
+            if ((event.due_us > deadline_us) || (event.pin_mask & pin_mask)) {
+                break;
+            }
+            pin_mask |= event.pin_mask;
+            levels |= event.levels & event.pin_mask;
+            batch[batch_size++] = event;
+            std::pop_heap(_events.begin(), _events.end(), EventLater());
+            _events.pop_back();
+        }
+        if (!_events.empty()) {
+            next_due_us = _events.front().due_us;
+        }
+        xSemaphoreGive(_mutex);
+
+        if (batch_size > 0) {
+            esp_err_t ret = esp_io_expander_write_output_stream(_expander.getDeviceHandle(), pin_mask, &levels, 1);
+            int64_t write_us = esp_timer_get_time();
+            _write_count++;
+            if (ret != ESP_OK) {
+                _error_count++;
+            }
+            for (size_t i = 0; i < batch_size; i++) {
+                int32_t error_us = static_cast<int32_t>(write_us - batch[i].due_us);
+                uint32_t late_us = (error_us > 0) ? error_us : 0;
+                _step_count++;
+                _timing_error_total_us += late_us;
+                if (late_us > _timing_error_max_us) {
+                    _timing_error_max_us = late_us;
+                }
+                if (_config.on_step_done) {
+                    _config.on_step_done(batch[i].timeline_id, batch[i].step_index, error_us);
+                }
+            }
+        }
+
+        if (next_due_us < 0) {
+            return;
+        }
+        int64_t delay_us = next_due_us - esp_timer_get_time();
+        if (delay_us <= static_cast<int64_t>(_config.merge_window_us)) {
+            // Already due, go on without the timer
+            continue;
+        }
+        esp_timer_stop(_timer);
+        if (esp_timer_start_once(_timer, (delay_us > TIMER_DELAY_MIN_US) ? delay_us : TIMER_DELAY_MIN_US) != ESP_OK) {
+            ESP_UTILS_LOGE("Start timer failed");
+        }
+        return;
+    }
+}
+
+} // namespace esp_expander
@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "chip/esp_expander_base.hpp"
+
+namespace esp_expander {
+
+/**
+ * @brief The executor of scheduled output changes, such as timed pulses, without blocking the caller
+ *
+ * @note  Steps of all submitted timelines are executed by a dedicated task woken by an `esp_timer` at the due time.
+ *        Steps due within `Config::merge_window_us` are merged into a single register write.
+ * @note  The pins should be set to output mode before submitting.
+ */
+class Timeline {
+public:
+    /**
+     * @brief Configuration for Timeline object
+     */
+    struct Config {
+        uint32_t merge_window_us = 50;      /*!< Steps due within this time from now share a write */
+        int task_priority = 15;             /*!< Priority of the executing task */
+        int task_stack_size = 4096;         /*!< Stack size of the executing task */
+        int task_core_id = -1;              /*!< Core of the executing task, -1 means no affinity */
+        /**
+         * Called by the executing task after each step is written, with the ID of the timeline, the index of the step
+         * and the timing error (actual write time - due time) in microseconds. Should return quickly.
+         */
+        std::function<void(int timeline_id, size_t step_index, int32_t error_us)> on_step_done;
+    };
+
+    /**
+     * @brief Step of a timeline
+     */
+    struct Step {
+        uint32_t offset_us;                 /*!< Time from the submission */
+        uint32_t pin_mask;                  /*!< Pins to set (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`) */
+        uint32_t levels;                    /*!< Levels of the pins, every bit represents a pin (HIGH / LOW) */
+    };
+
+    /**
+     * @brief Execution statistics
+     */
+    struct Stats {
+        uint32_t step_count;                /*!< Number of executed steps */
+        uint32_t write_count;               /*!< Number of register writes, less than `step_count` if merged */
+        uint32_t error_count;               /*!< Number of failed writes */
+        uint32_t timing_error_avg_us;       /*!< Average delay between the due time of a step and its write */
+        uint32_t timing_error_max_us;       /*!< Maximum delay between the due time of a step and its write */
+    };
+
+    /**
+     * @brief Construct a timeline executor
+     *
+     * @note  The expander object should be begun before calling `begin()` and should outlive this object.
+     *
+     * @param[in] expander IO expander object to control
+     * @param[in] config   Configuration for the object
+     */
+    Timeline(Base &expander, const Config &config): _expander(expander), _config(config) {}
+
+    /**
+     * @brief Construct a timeline executor with the default configuration
+     *
+     * @param[in] expander IO expander object to control
+     */
+    Timeline(Base &expander): Timeline(expander, Config()) {}
+
+    /**
+     * @brief Destruct object. This function will call `del()` to delete the object.
+     */
+    ~Timeline();
+
+    /**
+     * @brief Create the timer and the executing task
+     *
+     * @return true if success, otherwise false
+     */
+    bool begin(void);
+
+    /**
+     * @brief Drop the pending steps and release the resources
+     *
+     * @return true if success, otherwise false
+     */
+    bool del(void);
+
+    /**
+     * @brief Submit a timeline, the offsets of its steps start from now
+     *
+     * @param[in]  steps       Steps of the timeline, in any order
+     * @param[out] timeline_id ID of the timeline, can be nullptr
+     *
+     * @return true if success, otherwise false
+     */
+    bool submit(const std::vector<Step> &steps, int *timeline_id = nullptr);
+
+    /**
+     * @brief Submit a pulse on the pins, which are set to `level` after `delay_us` and set back after `width_us`
+     *
+     * @param[in]  pin_mask    Pin mask (Bitwise OR of `IO_EXPANDER_PIN_NUM_*`)
+     * @param[in]  level       Level of the pulse (HIGH / LOW)
+     * @param[in]  width_us    Width of the pulse
+     * @param[in]  delay_us    Time from now to the start of the pulse
+     * @param[out] timeline_id ID of the timeline, can be nullptr
+     *
+     * @return true if success, otherwise false
+     */
+    bool pulse(uint32_t pin_mask, uint8_t level, uint32_t width_us, uint32_t delay_us = 0, int *timeline_id = nullptr);
+
+    /**
+     * @brief Drop the pending steps of a timeline
+     *
+     * @param[in] timeline_id ID got from `submit()` or `pulse()`
+     *
+     * @return true if success, otherwise false
+     */
+    bool cancel(int timeline_id);
+
+    /**
+     * @brief Get the number of pending steps
+     *
+     * @return Number of steps
+     */
+    size_t getPendingSteps(void) const;
+
+    /**
+     * @brief Get the execution statistics
+     *
+     * @return Statistics
+     */
+    Stats getStats(void) const;
+
+    /**
+     * @brief Reset the execution statistics
+     */
+    void resetStats(void);
+
+private:
+    struct Event {
+        int64_t due_us;
+        uint32_t seq;                       // Keep the submission order of the events due at the same time
+        uint32_t pin_mask;
+        uint32_t levels;
+        int timeline_id;
+        size_t step_index;
+    };
+
+    static void timerCallback(void *arg);
+    static void taskEntry(void *arg);
+    void executeDueEvents(void);
+
+    Base &_expander;
+    Config _config;
+    SemaphoreHandle_t _mutex = nullptr;
+    std::vector<Event> _events;             // Min-heap by the due time
+    int _next_timeline_id = 0;
+    uint32_t _next_seq = 0;
+    esp_timer_handle_t _timer = nullptr;
+    std::atomic<TaskHandle_t> _task_handle{nullptr};
+    std::atomic<bool> _task_running{false};
+
+    uint32_t _step_count = 0;
+    uint32_t _write_count = 0;
+    uint32_t _error_count = 0;
+    uint64_t _timing_error_total_us = 0;
+    uint32_t _timing_error_max_us = 0;
+};
+
+} // namespace esp_expander
@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_expander_segment_encoder.hpp"
+
+namespace esp_expander {
+
+namespace {
+
+// 7-segment patterns of the digits and the letters, `gfedcba`
+const uint8_t DIGIT_PATTERNS[10] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F};
+const uint8_t LETTER_PATTERNS[26] = {
+    0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x3D, 0x76, 0x30, 0x1E, 0x75, 0x38, 0x37,
+    0x54, 0x3F, 0x73, 0x67, 0x50, 0x6D, 0x78, 0x3E, 0x1C, 0x2A, 0x76, 0x6E, 0x5B,
+};
+
+} // namespace
+
+uint8_t SegmentEncoder::encodeChar(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return DIGIT_PATTERNS[c - '0'];
+    }
+    switch (c) {
+    case 'c':
+        return 0x58;
+    case 'h':
+        return 0x74;
+    case 'o':
+        return 0x5C;
+    case 'u':
+        return 0x1C;
+    case '-':
+        return SEGMENT_G;
+    case '_':
+        return SEGMENT_D;
+    case '=':
+        return SEGMENT_D | SEGMENT_G;
+    default:
+        break;
+    }
+    if ((c >= 'a') && (c <= 'z')) {
+        return LETTER_PATTERNS[c - 'a'];
+    }
+    if ((c >= 'A') && (c <= 'Z')) {
+        return LETTER_PATTERNS[c - 'A'];
+    }
+
+    return 0;
+}
+
+} // namespace esp_expander
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_bit_defs.h"
+
+namespace esp_expander {
+
+/**
+ * @brief The encoder of 7-segment patterns, shared by the drivers of 7-segment digits (e.g. `SegmentDisplay` and the
+ *        display scan mode of `CH422G`)
+ */
+class SegmentEncoder {
+public:
+    /**
+     * Bits of the 7-segment patterns
+     */
+    constexpr static uint8_t SEGMENT_A = BIT(0);
+    constexpr static uint8_t SEGMENT_B = BIT(1);
+    constexpr static uint8_t SEGMENT_C = BIT(2);
+    constexpr static uint8_t SEGMENT_D = BIT(3);
+    constexpr static uint8_t SEGMENT_E = BIT(4);
+    constexpr static uint8_t SEGMENT_F = BIT(5);
+    constexpr static uint8_t SEGMENT_G = BIT(6);
+    constexpr static uint8_t SEGMENT_DP = BIT(7);
+
+    /**
+     * @brief Encode a character into a 7-segment pattern
+     *
+     * @note  Digits, letters (in the closest case that can be shown), space, '-', '_' and '=' are supported.
+     *
+     * @param[in] c Character
+     *
+     * @return Bitwise OR of `SEGMENT_*`, 0 if the character can't be shown
+     */
+    static uint8_t encodeChar(char c);
+
+    /**
+     * @brief Encode a string into the 7-segment patterns of the digits from the left, the remaining digits are cleared
+     *
+     * @note  A '.' is merged into the decimal point of the previous character, e.g. "12.34" takes 4 digits.
+     *
+     * @param[in]  text      String
+     * @param[out] segments  Patterns of the digits, bitwise OR of `SEGMENT_*`
+     * @param[in]  digit_num Number of the digits
+     *
+     * @return Number of the digits taken by the string
+     */
+    template <typename T>
+    static size_t encodeText(const char *text, T *segments, size_t digit_num)
+    {
+        size_t digit = 0;
+        for (; (*text != '\0') && (digit < digit_num); text++) {
+            if ((*text == '.') && (digit > 0) && !(segments[digit - 1] & SEGMENT_DP)) {
+                segments[digit - 1] |= SEGMENT_DP;
+                continue;
+            }
+            segments[digit++] = (*text == '.') ? SEGMENT_DP : encodeChar(*text);
+        }
+        for (size_t i = digit; i < digit_num; i++) {
+            segments[i] = 0;
+        }
+
+        return digit;
+    }
+};
+
+} // namespace esp_expander
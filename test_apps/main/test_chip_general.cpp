@@ -5,12 +5,16 @@
  */
 
 #include <memory>
+#include <vector>
 #include <inttypes.h>
 #include "driver/i2c.h"
+#include "driver/spi_master.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "unity.h"
 #include "unity_test_runner.h"
 #include "esp_io_expander.hpp"
@@ -173,3 +177,411 @@ CREATE_TEST_CASE(TCA95XX_8BIT)
 CREATE_TEST_CASE(TCA95XX_16BIT)
 CREATE_TEST_CASE(CH422G)
 CREATE_TEST_CASE(HT8574)
+CREATE_TEST_CASE(PCAL95XX_8BIT)
+CREATE_TEST_CASE(PCAL95XX_16BIT)
+CREATE_TEST_CASE(TCA6424)
+CREATE_TEST_CASE(MCP23017)
+CREATE_TEST_CASE(AW9523B)
+
+/* A pin of the TCA9554 on 'ESP32_S3_LCD_EV_BOARD_V1_5', whose input register follows the output level */
+#define TEST_WAIT_PIN           (0)
+#define TEST_WAIT_TIMEOUT_MS    (50)
+
+typedef struct {
+    std::shared_ptr<Base> expander;
+    SemaphoreHandle_t done;
+    bool result;
+} wait_task_arg_t;
+
+static void wait_level_task(void *arg)
+{
+    wait_task_arg_t *task_arg = static_cast<wait_task_arg_t *>(arg);
+
+    task_arg->result = task_arg->expander->waitFor(TEST_WAIT_PIN, HIGH);
+    xSemaphoreGive(task_arg->done);
+    vTaskDelete(nullptr);
+}
+
+TEST_CASE("test waitFor timeout and level", "[io_expander][wait]")
+{
+    std::shared_ptr<Base> expander = CREATE_DEVICE(
+                                         TCA95XX_8BIT, TEST_HOST_I2C_SCL_PIN, TEST_HOST_I2C_SDA_PIN, TEST_DEVICE_ADDRESS
+                                     );
+    TEST_ASSERT_MESSAGE(expander->init(), "Device initialization failed");
+    TEST_ASSERT_MESSAGE(expander->begin(), "Device begin failed");
+    TEST_ASSERT_MESSAGE(expander->pinMode(TEST_WAIT_PIN, OUTPUT), "Set pin mode failed");
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_WAIT_PIN, LOW), "Set pin low failed");
+
+    esp_io_expander_handle_t handle = expander->getDeviceHandle();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_io_expander_wait_level(handle, BIT(TEST_WAIT_PIN), 0, 0));
+    TickType_t start_tick = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL(
+        ESP_ERR_TIMEOUT, esp_io_expander_wait_level(handle, BIT(TEST_WAIT_PIN), 1, TEST_WAIT_TIMEOUT_MS)
+    );
+    TEST_ASSERT_TRUE(xTaskGetTickCount() - start_tick >= pdMS_TO_TICKS(TEST_WAIT_TIMEOUT_MS));
+
+    ESP_LOGI(TAG, "A task waiting for the level blocks the deletion until the pin goes high");
+    wait_task_arg_t task_arg = {
+        .expander = expander,
+        .done = xSemaphoreCreateBinary(),
+        .result = false,
+    };
+    TEST_ASSERT_NOT_NULL(task_arg.done);
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(wait_level_task, "wait_level", 4096, &task_arg, 5, nullptr));
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(task_arg.done, pdMS_TO_TICKS(TEST_WAIT_TIMEOUT_MS)));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_io_expander_del(handle));
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_WAIT_PIN, HIGH), "Set pin high failed");
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(task_arg.done, pdMS_TO_TICKS(TEST_WAIT_TIMEOUT_MS * 2)));
+    TEST_ASSERT_TRUE(task_arg.result);
+    vSemaphoreDelete(task_arg.done);
+    task_arg.expander = nullptr;
+
+    TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+}
+
+typedef struct {
+    int count;
+    uint32_t pin_num_mask;
+    uint32_t level_mask;
+} subscribe_result_t;
+
+static void subscribe_callback(esp_io_expander_handle_t handle, const esp_io_expander_event_t *event, void *user_ctx)
+{
+    subscribe_result_t *result = static_cast<subscribe_result_t *>(user_ctx);
+
+    result->count++;
+    result->pin_num_mask = event->pin_num_mask;
+    result->level_mask = event->level_mask;
+}
+
+TEST_CASE("test subscription edge delivery", "[io_expander][subscribe]")
+{
+    std::shared_ptr<Base> expander = CREATE_DEVICE(
+                                         TCA95XX_8BIT, TEST_HOST_I2C_SCL_PIN, TEST_HOST_I2C_SDA_PIN, TEST_DEVICE_ADDRESS
+                                     );
+    TEST_ASSERT_MESSAGE(expander->init(), "Device initialization failed");
+    TEST_ASSERT_MESSAGE(expander->begin(), "Device begin failed");
+    TEST_ASSERT_MESSAGE(expander->pinMode(TEST_WAIT_PIN, OUTPUT), "Set pin mode failed");
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_WAIT_PIN, LOW), "Set pin low failed");
+
+    subscribe_result_t result = {};
+    esp_io_expander_subscribe_config_t config = {
+        .pin_num_mask = BIT(TEST_WAIT_PIN),
+        .edge = IO_EXPANDER_EDGE_RISING,
+        .callback = subscribe_callback,
+        .user_ctx = &result,
+    };
+    int subscriber_id = -1;
+    TEST_ASSERT_MESSAGE(expander->subscribe(config, subscriber_id), "Subscribe failed");
+    // The first check only records the levels
+    TEST_ASSERT_MESSAGE(expander->checkChanges(), "Check changes failed");
+    TEST_ASSERT_EQUAL(0, result.count);
+
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_WAIT_PIN, HIGH), "Set pin high failed");
+    TEST_ASSERT_MESSAGE(expander->checkChanges(), "Check changes failed");
+    TEST_ASSERT_EQUAL(1, result.count);
+    TEST_ASSERT_EQUAL(BIT(TEST_WAIT_PIN), result.pin_num_mask);
+    TEST_ASSERT_TRUE(result.level_mask & BIT(TEST_WAIT_PIN));
+
+    ESP_LOGI(TAG, "Neither an unchanged level nor the unsubscribed edge is delivered");
+    TEST_ASSERT_MESSAGE(expander->checkChanges(), "Check changes failed");
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_WAIT_PIN, LOW), "Set pin low failed");
+    TEST_ASSERT_MESSAGE(expander->checkChanges(), "Check changes failed");
+    TEST_ASSERT_EQUAL(1, result.count);
+
+    TEST_ASSERT_MESSAGE(expander->unsubscribe(subscriber_id), "Unsubscribe failed");
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_WAIT_PIN, HIGH), "Set pin high failed");
+    TEST_ASSERT_MESSAGE(expander->checkChanges(), "Check changes failed");
+    TEST_ASSERT_EQUAL(1, result.count);
+
+    TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+}
+
+/* The 3-wire SPI pins of the LCD sub-board on the TCA9554 of 'ESP32_S3_LCD_EV_BOARD_V1_5' */
+#define TEST_SPI_3WIRE_CS_PIN   (1)
+#define TEST_SPI_3WIRE_SCK_PIN  (2)
+#define TEST_SPI_3WIRE_SDA_PIN  (3)
+#define TEST_SPI_3WIRE_BYTES    (64)
+
+static void spi_3wire_write_per_call(std::shared_ptr<Base> expander, const uint8_t *data, size_t len)
+{
+    TEST_ASSERT_TRUE(expander->digitalWrite(TEST_SPI_3WIRE_CS_PIN, LOW));
+    for (size_t i = 0; i < len; i++) {
+        uint16_t value = 0x100 | data[i];
+        for (int bit = 8; bit >= 0; bit--) {
+            TEST_ASSERT_TRUE(expander->digitalWrite(TEST_SPI_3WIRE_SCK_PIN, LOW));
+            TEST_ASSERT_TRUE(expander->digitalWrite(TEST_SPI_3WIRE_SDA_PIN, (value >> bit) & 1));
+            TEST_ASSERT_TRUE(expander->digitalWrite(TEST_SPI_3WIRE_SCK_PIN, HIGH));
+        }
+    }
+    TEST_ASSERT_TRUE(expander->digitalWrite(TEST_SPI_3WIRE_SCK_PIN, LOW));
+    TEST_ASSERT_TRUE(expander->digitalWrite(TEST_SPI_3WIRE_CS_PIN, HIGH));
+}
+
+TEST_CASE("benchmark 3-wire SPI serializer against per-call writes", "[io_expander][spi_3wire][benchmark]")
+{
+    std::shared_ptr<Base> expander = CREATE_DEVICE(
+                                         TCA95XX_8BIT, TEST_HOST_I2C_SCL_PIN, TEST_HOST_I2C_SDA_PIN, TEST_DEVICE_ADDRESS
+                                     );
+    TEST_ASSERT_MESSAGE(expander->init(), "Device initialization failed");
+    TEST_ASSERT_MESSAGE(expander->begin(), "Device begin failed");
+
+    SPI3Wire spi(*expander, {
+        .cs_pin = TEST_SPI_3WIRE_CS_PIN,
+        .scl_pin = TEST_SPI_3WIRE_SCK_PIN,
+        .sda_pin = TEST_SPI_3WIRE_SDA_PIN,
+    });
+    TEST_ASSERT_MESSAGE(spi.begin(), "SPI 3-wire begin failed");
+
+    std::vector<uint8_t> data(TEST_SPI_3WIRE_BYTES);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    spi_3wire_write_per_call(expander, data.data(), data.size());
+    int64_t per_call_us = esp_timer_get_time() - start_us;
+
+    start_us = esp_timer_get_time();
+    TEST_ASSERT_MESSAGE(spi.writeCommand(0x00, data.data() + 1, data.size() - 1), "SPI 3-wire write failed");
+    int64_t stream_us = esp_timer_get_time() - start_us;
+
+    ESP_LOGI(
+        TAG, "%d bytes, per-call: %" PRId64 " us (%d B/s), serializer: %" PRId64 " us (%d B/s)",
+        TEST_SPI_3WIRE_BYTES, per_call_us, static_cast<int>(TEST_SPI_3WIRE_BYTES * 1000000LL / per_call_us),
+        stream_us, static_cast<int>(TEST_SPI_3WIRE_BYTES * 1000000LL / stream_us)
+    );
+    TEST_ASSERT_TRUE_MESSAGE(stream_us < per_call_us, "Serializer should be faster than per-call writes");
+
+    TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+}
+
+/* The services set their pins to output mode by themselves, so each of them should begin on a fresh expander */
+static std::shared_ptr<Base> create_fresh_expander(void)
+{
+    std::shared_ptr<Base> expander = CREATE_DEVICE(
+                                         TCA95XX_8BIT, TEST_HOST_I2C_SCL_PIN, TEST_HOST_I2C_SDA_PIN, TEST_DEVICE_ADDRESS
+                                     );
+    TEST_ASSERT_MESSAGE(expander->init(), "Device initialization failed");
+    TEST_ASSERT_MESSAGE(expander->begin(), "Device begin failed");
+
+    return expander;
+}
+
+TEST_CASE("test services begin right after the expander", "[io_expander][service]")
+{
+    {
+        std::shared_ptr<Base> expander = create_fresh_expander();
+        SPI3Wire spi(*expander, {
+            .cs_pin = TEST_SPI_3WIRE_CS_PIN,
+            .scl_pin = TEST_SPI_3WIRE_SCK_PIN,
+            .sda_pin = TEST_SPI_3WIRE_SDA_PIN,
+        });
+        TEST_ASSERT_MESSAGE(spi.begin(), "SPI 3-wire begin failed");
+        TEST_ASSERT_EQUAL_MESSAGE(HIGH, expander->digitalRead(TEST_SPI_3WIRE_CS_PIN), "CS should start high");
+        TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+    }
+    {
+        std::shared_ptr<Base> expander = create_fresh_expander();
+        ShiftRegister shift_register(*expander, {
+            .clock_pin = 0,
+            .data_out_pin = 1,
+            .latch_pin = 2,
+        });
+        TEST_ASSERT_MESSAGE(shift_register.begin(), "Shift register begin failed");
+        TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+    }
+    {
+        std::shared_ptr<Base> expander = create_fresh_expander();
+        HD44780 lcd(*expander);
+        TEST_ASSERT_MESSAGE(lcd.begin(), "HD44780 begin failed");
+        TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+    }
+    {
+        std::shared_ptr<Base> expander = create_fresh_expander();
+        SegmentDisplay display(*expander, {
+            .segment_pins = {0, 1, 2, 3, 4, 5, 6},
+            .digit_pins = {7},
+        });
+        TEST_ASSERT_MESSAGE(display.begin(), "Segment display begin failed");
+        TEST_ASSERT_MESSAGE(display.del(), "Segment display del failed");
+        TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+    }
+    {
+        std::shared_ptr<Base> expander = create_fresh_expander();
+        Stepper stepper(*expander, {
+            .motors = {{.pins = {0, 1, 2, 3}}},
+        });
+        TEST_ASSERT_MESSAGE(stepper.begin(), "Stepper begin failed");
+        TEST_ASSERT_MESSAGE(stepper.del(), "Stepper del failed");
+        TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+    }
+}
+
+/* The rule is triggered by the level of `TEST_WAIT_PIN`, which is driven by the test itself */
+#define TEST_RULE_OUTPUT_PIN    (1)
+
+TEST_CASE("test rule forcing an output and releasing it", "[io_expander][rule]")
+{
+    std::shared_ptr<Base> expander = create_fresh_expander();
+    TEST_ASSERT_MESSAGE(
+        expander->multiPinModeOutput(BIT(TEST_WAIT_PIN) | BIT(TEST_RULE_OUTPUT_PIN), 0), "Set pins output failed"
+    );
+
+    esp_io_expander_rule_t rule = {
+        .input_pin_num_mask = BIT(TEST_WAIT_PIN),
+        .input_level_mask = BIT(TEST_WAIT_PIN),
+        .output_pin_num_mask = BIT(TEST_RULE_OUTPUT_PIN),
+        .output_level_mask = BIT(TEST_RULE_OUTPUT_PIN),
+    };
+    int rule_id = -1;
+    TEST_ASSERT_MESSAGE(expander->addRule(rule, rule_id), "Add rule failed");
+    TEST_ASSERT_MESSAGE(expander->checkChanges(), "Check changes failed");
+    TEST_ASSERT_EQUAL(LOW, expander->digitalRead(TEST_RULE_OUTPUT_PIN));
+
+    ESP_LOGI(TAG, "The active rule forces the output, the level set by users is applied once released");
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_WAIT_PIN, HIGH), "Set pin high failed");
+    TEST_ASSERT_MESSAGE(expander->checkChanges(), "Check changes failed");
+    TEST_ASSERT_EQUAL(HIGH, expander->digitalRead(TEST_RULE_OUTPUT_PIN));
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_RULE_OUTPUT_PIN, LOW), "Set forced pin failed");
+    TEST_ASSERT_EQUAL(HIGH, expander->digitalRead(TEST_RULE_OUTPUT_PIN));
+
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_WAIT_PIN, LOW), "Set pin low failed");
+    TEST_ASSERT_MESSAGE(expander->checkChanges(), "Check changes failed");
+    TEST_ASSERT_EQUAL(LOW, expander->digitalRead(TEST_RULE_OUTPUT_PIN));
+
+    esp_io_expander_rule_stats_t stats = {};
+    TEST_ASSERT_MESSAGE(expander->getRuleStats(stats), "Get rule stats failed");
+    TEST_ASSERT_EQUAL(2, stats.write_count);
+    TEST_ASSERT_MESSAGE(expander->removeRule(rule_id), "Remove rule failed");
+
+    TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+}
+
+/* The inputs of TCA9554 have internal pull-ups, so the released IO reads high level */
+#define TEST_OPEN_DRAIN_PIN     (2)
+
+TEST_CASE("test open-drain assert and release", "[io_expander][open_drain]")
+{
+    std::shared_ptr<Base> expander = create_fresh_expander();
+    esp_io_expander_handle_t handle = expander->getDeviceHandle();
+    TEST_ASSERT_MESSAGE(expander->pinMode(TEST_OPEN_DRAIN_PIN, OUTPUT_OPEN_DRAIN), "Set pin open-drain failed");
+    TEST_ASSERT_EQUAL(HIGH, expander->digitalRead(TEST_OPEN_DRAIN_PIN));
+
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_OPEN_DRAIN_PIN, LOW), "Assert pin failed");
+    TEST_ASSERT_EQUAL(LOW, expander->digitalRead(TEST_OPEN_DRAIN_PIN));
+
+    ESP_LOGI(TAG, "The output functions leave the asserted IO unchanged");
+    TEST_ASSERT_EQUAL(ESP_OK, esp_io_expander_set_output(handle, BIT(TEST_OPEN_DRAIN_PIN), BIT(TEST_OPEN_DRAIN_PIN)));
+    uint32_t level_mask = BIT(TEST_OPEN_DRAIN_PIN);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_io_expander_write_output_stream(handle, BIT(TEST_OPEN_DRAIN_PIN), &level_mask, 1));
+    TEST_ASSERT_EQUAL(LOW, expander->digitalRead(TEST_OPEN_DRAIN_PIN));
+
+    TEST_ASSERT_MESSAGE(expander->digitalWrite(TEST_OPEN_DRAIN_PIN, HIGH), "Release pin failed");
+    TEST_ASSERT_EQUAL(HIGH, expander->digitalRead(TEST_OPEN_DRAIN_PIN));
+
+    ESP_LOGI(TAG, "The IO quits the open-drain mode once its direction is set");
+    TEST_ASSERT_MESSAGE(expander->pinMode(TEST_OPEN_DRAIN_PIN, INPUT), "Set pin input failed");
+    TEST_ASSERT_EQUAL(
+        ESP_ERR_INVALID_STATE, esp_io_expander_set_open_drain_level(handle, BIT(TEST_OPEN_DRAIN_PIN), 0)
+    );
+
+    TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+}
+
+/* The input register of CH422G follows the levels of IO0-7 in output mode */
+#define TEST_CH422G_IO_MASK     (0xFF)
+
+TEST_CASE("test CH422G writes zero bytes and skips unchanged ones", "[io_expander][ch422g]")
+{
+    std::shared_ptr<Base> expander = CREATE_DEVICE(
+                                         CH422G, TEST_HOST_I2C_SCL_PIN, TEST_HOST_I2C_SDA_PIN, TEST_DEVICE_ADDRESS
+                                     );
+    TEST_ASSERT_MESSAGE(expander->init(), "Device initialization failed");
+    TEST_ASSERT_MESSAGE(expander->begin(), "Device begin failed");
+    TEST_ASSERT_MESSAGE(expander->multiPinMode(TEST_CH422G_IO_MASK, OUTPUT), "Set pins output failed");
+
+    ESP_LOGI(TAG, "Driving all IO0-7 low writes a zero WR-IO byte");
+    TEST_ASSERT_MESSAGE(expander->multiDigitalWrite(TEST_CH422G_IO_MASK, LOW), "Set pins low failed");
+    TEST_ASSERT_EQUAL(0, expander->multiDigitalRead(TEST_CH422G_IO_MASK));
+    TEST_ASSERT_MESSAGE(expander->multiDigitalWrite(TEST_CH422G_IO_MASK, LOW), "Set unchanged pins failed");
+    TEST_ASSERT_EQUAL(0, expander->multiDigitalRead(TEST_CH422G_IO_MASK));
+
+    TEST_ASSERT_MESSAGE(expander->multiDigitalWrite(TEST_CH422G_IO_MASK, HIGH), "Set pins high failed");
+    TEST_ASSERT_EQUAL(TEST_CH422G_IO_MASK, expander->multiDigitalRead(TEST_CH422G_IO_MASK));
+
+    ESP_LOGI(TAG, "Reset writes all registers whatever the shadow is");
+    TEST_ASSERT_MESSAGE(expander->multiDigitalWrite(TEST_CH422G_IO_MASK, LOW), "Set pins low failed");
+    TEST_ASSERT_MESSAGE(expander->reset(), "Device reset failed");
+    TEST_ASSERT_EQUAL(TEST_CH422G_IO_MASK, expander->multiDigitalRead(TEST_CH422G_IO_MASK));
+
+    TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+}
+
+/* The SPI pins connected to a MCP23S17, change them according to the board */
+#define TEST_SPI_HOST_ID        (SPI2_HOST)
+#define TEST_SPI_SCLK_PIN       (12)
+#define TEST_SPI_MOSI_PIN       (11)
+#define TEST_SPI_MISO_PIN       (13)
+#define TEST_SPI_CS_PIN         (10)
+#define TEST_BENCHMARK_OPS      (1000)
+
+static void benchmark_ops(const char *name, std::shared_ptr<Base> expander)
+{
+    TEST_ASSERT_MESSAGE(expander->multiPinMode(IO_EXPANDER_PIN_NUM_0 | IO_EXPANDER_PIN_NUM_1, OUTPUT), "Set pin mode failed");
+
+    int64_t start_us = esp_timer_get_time();
+    for (int i = 0; i < TEST_BENCHMARK_OPS; i++) {
+        TEST_ASSERT_TRUE(expander->digitalWrite(IO_EXPANDER_PIN_NUM_0, i & 1));
+    }
+    int64_t write_us = esp_timer_get_time() - start_us;
+
+    start_us = esp_timer_get_time();
+    for (int i = 0; i < TEST_BENCHMARK_OPS; i++) {
+        TEST_ASSERT_TRUE(expander->multiDigitalRead(IO_EXPANDER_PIN_NUM_0 | IO_EXPANDER_PIN_NUM_1) >= 0);
+    }
+    int64_t read_us = esp_timer_get_time() - start_us;
+
+    std::vector<uint32_t> values(TEST_BENCHMARK_OPS);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = (i & 1) ? IO_EXPANDER_PIN_NUM_1 : IO_EXPANDER_PIN_NUM_0;
+    }
+    start_us = esp_timer_get_time();
+    TEST_ASSERT_TRUE(
+        expander->multiDigitalWriteStream(IO_EXPANDER_PIN_NUM_0 | IO_EXPANDER_PIN_NUM_1, values.data(), values.size())
+    );
+    int64_t stream_us = esp_timer_get_time() - start_us;
+
+    ESP_LOGI(
+        TAG, "%s: write %d ops/s, read %d ops/s, stream %d values/s", name,
+        static_cast<int>(TEST_BENCHMARK_OPS * 1000000LL / write_us),
+        static_cast<int>(TEST_BENCHMARK_OPS * 1000000LL / read_us),
+        static_cast<int>(TEST_BENCHMARK_OPS * 1000000LL / stream_us)
+    );
+}
+
+TEST_CASE("benchmark MCP23S17 on SPI against I2C drivers", "[io_expander][MCP23S17][benchmark]")
+{
+    const spi_bus_config_t bus_config = {
+        .mosi_io_num = TEST_SPI_MOSI_PIN,
+        .miso_io_num = TEST_SPI_MISO_PIN,
+        .sclk_io_num = TEST_SPI_SCLK_PIN,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+    };
+    TEST_ASSERT_EQUAL(spi_bus_initialize(TEST_SPI_HOST_ID, &bus_config, SPI_DMA_CH_AUTO), ESP_OK);
+
+    std::shared_ptr<Base> expander = std::make_shared<MCP23S17>(TEST_SPI_HOST_ID, TEST_SPI_CS_PIN);
+    TEST_ASSERT_MESSAGE(expander->init(), "Device initialization failed");
+    TEST_ASSERT_MESSAGE(expander->begin(), "Device begin failed");
+    benchmark_ops("MCP23S17", expander);
+    TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+    expander = nullptr;
+    TEST_ASSERT_EQUAL(spi_bus_free(TEST_SPI_HOST_ID), ESP_OK);
+
+    expander = CREATE_DEVICE(TCA95XX_8BIT, TEST_HOST_I2C_SCL_PIN, TEST_HOST_I2C_SDA_PIN, TEST_DEVICE_ADDRESS);
+    TEST_ASSERT_MESSAGE(expander->init(), "Device initialization failed");
+    TEST_ASSERT_MESSAGE(expander->begin(), "Device begin failed");
+    benchmark_ops("TCA95XX_8BIT", expander);
+    TEST_ASSERT_MESSAGE(expander->del(), "Device del failed");
+}